@@ -0,0 +1,100 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __BENCHMARK_HEADER__
+#define __BENCHMARK_HEADER__
+
+#include "../src/regraderprocess.h"
+#include <chrono>
+#include <cstdio>
+
+/**
+ * convenience utilities shared by the benchmarks
+ * the benchmarks run the DSP classes directly (e.g. without a VST host)
+ */
+namespace Igorski {
+namespace Bench {
+
+    typedef std::chrono::steady_clock Clock;
+
+    // elapsed time in nanoseconds since given start time
+
+    inline double elapsedNs( Clock::time_point start )
+    {
+        return ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - start ).count();
+    }
+
+    // fill given buffer with deterministic white noise in the -1 to +1 range
+
+    template <typename SampleType>
+    void fillNoise( SampleType* buffer, int bufferSize, uint32_t& seed )
+    {
+        for ( int i = 0; i < bufferSize; ++i ) {
+            seed = seed * 1664525 + 1013904223;
+            buffer[ i ] = ( SampleType ) (( int32_t ) seed ) / ( SampleType ) 2147483648.0;
+        }
+    }
+
+    // configure given process to have all of its effects enabled
+    // (bit crusher and decimator before, filter and flanger after the delay)
+
+    template <typename SampleType>
+    void enableAllEffects( RegraderProcess<SampleType>* process )
+    {
+        process->syncDelayToHost   = false;
+        process->bitCrusherPostMix = false;
+        process->decimatorPostMix  = false;
+        process->filterPostMix     = true;
+        process->flangerPostMix    = true;
+
+        process->setDelayTime( .05f );
+        process->setDelayFeedback( .5f );
+        process->setDelayMix( .5f );
+
+        process->bitCrusher->setAmount( .5f );
+        process->bitCrusher->setLFO( .3f, .5f );
+        process->decimator->setBits( 16 );
+        process->decimator->setRate( .7f );
+        process->filter->updateProperties( .5f, .5f, .3f, .5f );
+        process->flanger->setRate( .3f );
+        process->flanger->setWidth( .5f );
+        process->flanger->setFeedback( .5f );
+        process->flanger->setDelay( .3f );
+    }
+
+    // the benchmarks (see their respective source files)
+
+    void runFusedChainBenchmark();
+    void runSampleSizeBenchmark();
+    void runDelayInterpolationBenchmark();
+    void runDenormalBenchmark();
+    void runOversamplingBenchmark();
+    void runKernelBenchmark();
+
+    // writes the results as JSON to given file ("-" for stdout), when not null
+    // returns false when the file could not be written
+
+    bool runClassBenchmark( const char* jsonFile );
+}
+}
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include <cmath>
+#include <vector>
+
+namespace Igorski {
+namespace Bench {
+
+/**
+ * runs a feedback delay over a noise signal directly on a DelayLine using given
+ * interpolation kernel (or none, when delay is an integer amount of samples), returning
+ * the processing time in nanoseconds. When modulated, the delay time is swept for
+ * each frame and the frames are read one at a time (as a modulated delay would)
+ */
+template <typename SampleType>
+static double runDelay( double delay, Interpolation::Type interpolation, bool modulated, int duration )
+{
+    const int numChannels = 2;
+    const int blockSize   = 256;
+    const SampleType feedback = ( SampleType ) .5;
+
+    DelayLine<SampleType>* delayLine = new DelayLine<SampleType>();
+    delayLine->resize( numChannels, ( int ) delay * 2 );
+
+    std::vector<SampleType> input( blockSize * numChannels );
+    std::vector<SampleType> output( blockSize * numChannels );
+
+    uint32_t seed = 1;
+    double ns   = 0.0;
+    double modulatedDelay = delay;
+    double modulationStep = .001;
+    int maxRunLength = DelayLine<SampleType>::getMaxReadLength( delay, interpolation );
+
+    for ( int processed = 0; processed < duration; processed += blockSize )
+    {
+        fillNoise( input.data(), blockSize * numChannels, seed );
+
+        Clock::time_point start = Clock::now();
+
+        if ( modulated ) {
+            for ( int i = 0; i < blockSize; ++i ) {
+                SampleType* frame  = &output[ i * numChannels ];
+                SampleType* writer = delayLine->getFrame( 0 );
+
+                // sweep the delay time between 90 and 110 % of given delay
+
+                modulatedDelay += modulationStep;
+
+                if ( modulatedDelay > delay * 1.1 || modulatedDelay < delay * .9 )
+                    modulationStep = -modulationStep;
+
+                delayLine->readFrame( modulatedDelay, interpolation, frame, numChannels );
+
+                for ( int c = 0; c < numChannels; ++c )
+                    writer[ c ] = input[ i * numChannels + c ] + frame[ c ] * feedback;
+
+                delayLine->advance( 1 );
+            }
+        }
+        else {
+            for ( int offset = 0; offset < blockSize; offset += maxRunLength ) {
+                int runLength = std::min( maxRunLength, blockSize - offset );
+                SampleType* in  = &input[ offset * numChannels ];
+                SampleType* out = &output[ offset * numChannels ];
+
+                delayLine->read( delay, interpolation, out, numChannels, runLength );
+
+                for ( int i = 0; i < runLength * numChannels; ++i )
+                    in[ i ] += out[ i ] * feedback;
+
+                delayLine->write( in, numChannels, runLength );
+            }
+        }
+        ns += elapsedNs( start );
+    }
+    delete delayLine;
+
+    return ns;
+}
+
+/**
+ * compares the cost of the delay interpolation kernels against
+ * reading the delay at an integer amount of samples
+ */
+template <typename SampleType>
+static void compareKernels( const char* sampleTypeName )
+{
+    const int numChannels = 2;
+    const int duration    = ( int ) VST::SAMPLE_RATE * 10;
+    const double delay    = 441.37; // ~10 ms at 44.1 kHz
+
+    const char* names[] = { "linear", "hermite", "lagrange" };
+    const Interpolation::Type kernels[] = {
+        Interpolation::LINEAR, Interpolation::HERMITE, Interpolation::LAGRANGE
+    };
+
+    double processedSamples = ( double ) duration * numChannels;
+
+    printf( "Delay interpolation kernels (%s, %d channels, %d seconds at %.0f Hz, %.2f sample delay)\n\n",
+            sampleTypeName, numChannels, duration / ( int ) VST::SAMPLE_RATE, VST::SAMPLE_RATE, delay );
+    printf( "%10s %16s %22s\n", "kernel", "block ns/sample", "modulated ns/sample" );
+
+    printf( "%10s %16.2f %22s\n", "integer",
+            runDelay<SampleType>( floor( delay ), Interpolation::LINEAR, false, duration ) / processedSamples, "-" );
+
+    for ( int k = 0; k < 3; ++k ) {
+        double blockNs     = runDelay<SampleType>( delay, kernels[ k ], false, duration );
+        double modulatedNs = runDelay<SampleType>( delay, kernels[ k ], true,  duration );
+
+        printf( "%10s %16.2f %22.2f\n", names[ k ], blockNs / processedSamples, modulatedNs / processedSamples );
+    }
+    printf( "\n" );
+}
+
+void runDelayInterpolationBenchmark()
+{
+    compareKernels<float>( "float" );
+    compareKernels<double>( "double" );
+}
+
+}
+}
@@ -0,0 +1,185 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include "../src/denormalguard.h"
+#include <vector>
+
+namespace Igorski {
+namespace Bench {
+
+/**
+ * renders a short noise burst followed by silence through given processing function (a feedback path
+ * decaying toward zero once the burst ends), returning the processing time of each block of the
+ * silence (in nanoseconds). Optionally with a DenormalGuard in scope (as in Regrader::process())
+ */
+template <typename SampleType, typename ProcessFunction>
+static std::vector<double> renderTail( ProcessFunction process, int numChannels, int blockSize,
+                                       int burstDuration, int tailDuration, bool guarded )
+{
+    std::vector<SampleType> buffer( blockSize * numChannels );
+    std::vector<double> blockTimes;
+
+    uint32_t seed = 1;
+
+    for ( int processed = 0; processed < burstDuration + tailDuration; processed += blockSize )
+    {
+        bool isTail = processed >= burstDuration;
+
+        if ( isTail )
+            std::fill( buffer.begin(), buffer.end(), ( SampleType ) 0 );
+        else
+            fillNoise( buffer.data(), blockSize * numChannels, seed );
+
+        Clock::time_point start = Clock::now();
+
+        if ( guarded ) {
+            DenormalGuard denormalGuard;
+            process( buffer.data(), blockSize );
+        } else {
+            process( buffer.data(), blockSize );
+        }
+        double ns = elapsedNs( start );
+
+        if ( isTail )
+            blockTimes.push_back( ns );
+    }
+    return blockTimes;
+}
+
+/**
+ * renders the decaying tail of each of the feedback paths in the effect chain with and
+ * without the denormal guard. The flushing of the feedback state is built into the effects
+ * so the unguarded columns show its effectiveness (and the guarded columns the combination)
+ */
+template <typename SampleType>
+static void compareTails( const char* sampleTypeName )
+{
+    const int numChannels   = 2;
+    const int blockSize     = 512;
+    const int burstDuration = ( int ) VST::SAMPLE_RATE / 2;
+    const int tailDuration  = ( int ) VST::SAMPLE_RATE * 30;
+    const int windowSeconds = 3;
+    const int delayTime     = 441;
+
+    std::vector<double> times[ 8 ];
+
+    for ( int guarded = 0; guarded < 2; ++guarded )
+    {
+        // the (static) filter, as applied onto the silent input before the delay
+
+        Filter<SampleType> filter( numChannels );
+        filter.updateProperties( .5f, .5f, 0.f, .5f );
+
+        times[ guarded ] = renderTail<SampleType>( [ & ]( SampleType* buffer, int bufferSize ) {
+            filter.process( buffer, numChannels, bufferSize );
+        }, numChannels, blockSize, burstDuration, tailDuration, guarded == 1 );
+
+        Flanger<SampleType> flanger( numChannels );
+        flanger.setRate( .3f );
+        flanger.setWidth( .5f );
+        flanger.setFeedback( .5f );
+
+        times[ 2 + guarded ] = renderTail<SampleType>( [ & ]( SampleType* buffer, int bufferSize ) {
+            flanger.process( buffer, numChannels, bufferSize );
+        }, numChannels, blockSize, burstDuration, tailDuration, guarded == 1 );
+
+        // the full chain with a long delay, which does not become idle during the tail as its feedback
+        // takes minutes to decay, while the effects after the delay decay in between its repeats
+
+        RegraderProcess<SampleType>* process = new RegraderProcess<SampleType>( numChannels, blockSize );
+        enableAllEffects( process );
+        process->bitCrusher->setAmount( 1.f ); // at full resolution, as the crusher adds a small DC offset
+        process->bitCrusher->setLFO( 0.f, 0.f );
+        process->setDelayTime( .2f );          // 1 second (of MAX_DELAY_TIME_MS)
+        process->setDelayFeedback( .95f );
+
+        SampleType* channels[ numChannels ];
+
+        times[ 4 + guarded ] = renderTail<SampleType>( [ & ]( SampleType* buffer, int bufferSize ) {
+            for ( int c = 0; c < numChannels; ++c )
+                channels[ c ] = buffer + c * bufferSize;
+
+            process->process( channels, channels, numChannels, numChannels, bufferSize, bufferSize * sizeof( SampleType ));
+        }, numChannels, blockSize, burstDuration, tailDuration, guarded == 1 );
+
+        delete process;
+
+        // a short delay with a long feedback tail on a bare DelayLine (e.g. without the idle
+        // detection and flushing of RegraderProcess, which would stop the tail long before it
+        // reaches the denormal range)
+
+        DelayLine<SampleType> delayLine;
+        delayLine.resize( numChannels, delayTime );
+        std::vector<SampleType> delayed( blockSize * numChannels );
+
+        times[ 6 + guarded ] = renderTail<SampleType>( [ & ]( SampleType* buffer, int bufferSize ) {
+            for ( int offset = 0; offset < bufferSize; offset += delayTime ) {
+                int length = std::min( delayTime, bufferSize - offset );
+                SampleType* run = buffer + offset * numChannels;
+
+                delayLine.read( delayTime, delayed.data(), numChannels, length );
+
+                for ( int i = 0; i < length * numChannels; ++i )
+                    run[ i ] += delayed[ i ] * ( SampleType ) .95;
+
+                delayLine.write( run, numChannels, length );
+            }
+        }, numChannels, blockSize, burstDuration, tailDuration, guarded == 1 );
+    }
+
+    printf( "Decaying tails (%s, %d sample blocks, %d seconds of silence after a noise burst, us/block)\n\n",
+            sampleTypeName, blockSize, tailDuration / ( int ) VST::SAMPLE_RATE );
+    printf( "%10s %22s %22s %22s %22s\n", "", "filter", "flanger", "full chain (1s delay)", "bare delay feedback" );
+    printf( "%10s %11s %10s %11s %10s %11s %10s %11s %10s\n", "seconds",
+            "unguarded", "guarded", "unguarded", "guarded", "unguarded", "guarded", "unguarded", "guarded" );
+
+    size_t blocksPerWindow = ( size_t ) ( windowSeconds * VST::SAMPLE_RATE / blockSize );
+
+    for ( size_t offset = 0; offset < times[ 0 ].size(); offset += blocksPerWindow )
+    {
+        size_t end = std::min( times[ 0 ].size(), offset + blocksPerWindow );
+        int second = ( int ) ( offset / blocksPerWindow ) * windowSeconds;
+
+        printf( "%4d - %-3d", second, second + windowSeconds );
+
+        for ( int t = 0; t < 8; ++t ) {
+            double sum = 0.0;
+
+            for ( size_t i = offset; i < end; ++i )
+                sum += times[ t ][ i ];
+
+            printf( " %*.2f", ( t % 2 == 0 ) ? 11 : 10, sum / ( double ) ( end - offset ) / 1000.0 );
+        }
+        printf( "\n" );
+    }
+    printf( "\n" );
+}
+
+void runDenormalBenchmark()
+{
+    compareTails<float>( "float" );
+    compareTails<double>( "double" );
+}
+
+}
+}
@@ -0,0 +1,341 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include "../src/denormalguard.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Igorski {
+namespace Bench {
+
+/**
+ * measures the processing time of each DSP class in isolation (and of the full chain) over a sweep of
+ * block sizes, sample rates and channel counts. The results are printed as a summary table and
+ * optionally written as JSON, so the results of different releases can be compared
+ */
+
+static const int BLOCK_SIZES[]    = { 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+static const int SAMPLE_RATES[]   = { 44100, 48000, 96000 };
+static const int CHANNEL_COUNTS[] = { 1, 2, 6 };
+
+// the amount of audio processed by each measurement and the amount of measurements
+// of which the fastest is reported (the first of which warms up the caches)
+
+static const double MEASURED_SECONDS = .25;
+static const int REPETITIONS         = 3;
+
+// the configuration the summary table is printed for
+
+static const int SUMMARY_SAMPLE_RATE = 44100;
+static const int SUMMARY_CHANNELS    = 2;
+
+struct Result {
+    std::string benchmark;
+    const char* sampleType;
+    int blockSize;
+    int sampleRate;
+    int channels;
+    double nsPerSample;
+    double realtimeFactor;
+};
+
+struct Configuration {
+    int blockSize;
+    int sampleRate;
+    int channels;
+};
+
+/**
+ * processes MEASURED_SECONDS of noise in blocks of the configured size through given function
+ * (receiving the offset of the block in frames and its length), which processes either a block of
+ * given interleaved buffer or a block of given channel buffers. The processing is repeated, the
+ * fastest repetition is returned in nanoseconds per sample (e.g. per frame per channel)
+ */
+template <typename SampleType, typename ProcessFunction>
+static double measure( ProcessFunction process, const Configuration& configuration,
+                       std::vector<SampleType>& signal )
+{
+    int duration = ( int )( configuration.sampleRate * MEASURED_SECONDS );
+    duration     = std::max( 1, duration / configuration.blockSize ) * configuration.blockSize;
+
+    signal.resize(( size_t ) duration * configuration.channels );
+
+    double fastestNs = 0.0;
+
+    for ( int repetition = 0; repetition < REPETITIONS; ++repetition )
+    {
+        uint32_t seed = 1;
+        fillNoise( signal.data(), ( int ) signal.size(), seed );
+
+        // denormals are flushed as in Regrader::process(), so decaying state does not skew the results
+
+        DenormalGuard denormalGuard;
+        Clock::time_point start = Clock::now();
+
+        for ( int offset = 0; offset < duration; offset += configuration.blockSize )
+            process( offset, configuration.blockSize, duration );
+
+        double ns = elapsedNs( start );
+        fastestNs = ( repetition == 0 ) ? ns : std::min( fastestNs, ns );
+    }
+    return fastestNs / (( double ) duration * configuration.channels );
+}
+
+template <typename SampleType>
+static const char* getSampleTypeName()
+{
+    return sizeof( SampleType ) == sizeof( double ) ? "double" : "float";
+}
+
+/**
+ * measures each of the (sample type specific) DSP classes at given configuration, the
+ * classes processing interleaved frames are fed consecutive blocks of an interleaved
+ * signal, the classes processing separate channels consecutive blocks of each channel
+ */
+template <typename SampleType>
+static void measureClasses( const Configuration& configuration, std::vector<Result>& results )
+{
+    VST::SAMPLE_RATE = ( float ) configuration.sampleRate;
+
+    int channels = configuration.channels;
+
+    std::vector<SampleType> signal;
+    std::vector<SampleType*> blockChannels( channels );
+
+    // a block of the interleaved signal
+
+    auto interleaved = [ &signal, channels ]( int offset ) {
+        return signal.data() + ( size_t ) offset * channels;
+    };
+
+    // the channel buffers of a block of the signal (where the channels are laid out consecutively)
+
+    auto separate = [ &signal, &blockChannels, channels ]( int offset, int duration ) {
+        for ( int c = 0; c < channels; ++c )
+            blockChannels[ c ] = signal.data() + ( size_t ) c * duration + offset;
+        return blockChannels.data();
+    };
+
+    auto addResult = [ & ]( const char* benchmark, double nsPerSample ) {
+        results.push_back({ benchmark, getSampleTypeName<SampleType>(), configuration.blockSize, configuration.sampleRate,
+                            channels, nsPerSample, 1e9 / ( nsPerSample * channels * configuration.sampleRate ) });
+    };
+
+    {
+        BitCrusher<SampleType> bitCrusher( .5f, 1.f, 1.f );
+        bitCrusher.setLFO( .3f, .5f );
+
+        addResult( "BitCrusher::process", measure<SampleType>( [ & ]( int offset, int blockSize, int ) {
+            bitCrusher.process( interleaved( offset ), channels, blockSize );
+        }, configuration, signal ));
+    }
+
+    {
+        Decimator<SampleType> decimator( 16, .7f );
+
+        addResult( "Decimator::process", measure<SampleType>( [ & ]( int offset, int blockSize, int ) {
+            decimator.process( interleaved( offset ), channels, blockSize );
+        }, configuration, signal ));
+    }
+
+    for ( int hasLFO = 0; hasLFO < 2; ++hasLFO )
+    {
+        Filter<SampleType> filter( channels );
+        filter.updateProperties( .5f, .5f, hasLFO ? .3f : 0.f, .5f );
+
+        addResult( hasLFO ? "Filter::process (LFO)" : "Filter::process", measure<SampleType>( [ & ]( int offset, int blockSize, int ) {
+            filter.process( interleaved( offset ), channels, blockSize );
+        }, configuration, signal ));
+    }
+
+    {
+        Flanger<SampleType> flanger( channels );
+        flanger.setRate( .3f );
+        flanger.setWidth( .5f );
+        flanger.setFeedback( .5f );
+        flanger.setDelay( .3f );
+
+        addResult( "Flanger::process", measure<SampleType>( [ & ]( int offset, int blockSize, int ) {
+            flanger.process( interleaved( offset ), channels, blockSize );
+        }, configuration, signal ));
+    }
+
+    {
+        Limiter limiter( 10.f, 500.f, .6f );
+
+        addResult( "Limiter::process", measure<SampleType>( [ & ]( int offset, int blockSize, int duration ) {
+            limiter.process( separate( offset, duration ), blockSize, channels );
+        }, configuration, signal ));
+    }
+
+    {
+        RegraderProcess<SampleType> process( channels, configuration.blockSize );
+        enableAllEffects( &process );
+
+        uint32_t frameSize = configuration.blockSize * sizeof( SampleType );
+
+        addResult( "RegraderProcess::process", measure<SampleType>( [ & ]( int offset, int blockSize, int duration ) {
+            SampleType** buffers = separate( offset, duration );
+            process.process( buffers, buffers, channels, channels, blockSize, frameSize );
+        }, configuration, signal ));
+    }
+}
+
+/**
+ * measures the operations of the (single precision) AudioBuffer at given configuration
+ * (as these operate on the full buffer, the same buffers are processed repeatedly)
+ */
+static void measureAudioBuffer( const Configuration& configuration, std::vector<Result>& results )
+{
+    int channels = configuration.channels;
+
+    AudioBuffer source( channels, configuration.blockSize );
+    AudioBuffer target( channels, configuration.blockSize );
+    AudioBuffer silent( channels, configuration.blockSize );
+
+    std::vector<float> signal;
+
+    auto addResult = [ & ]( const char* benchmark, double nsPerSample ) {
+        results.push_back({ benchmark, "float", configuration.blockSize, configuration.sampleRate,
+                            channels, nsPerSample, 1e9 / ( nsPerSample * channels * configuration.sampleRate ) });
+    };
+
+    for ( int c = 0; c < channels; ++c ) {
+        uint32_t seed = c + 1;
+        fillNoise( source.getBufferForChannel( c ), configuration.blockSize, seed );
+    }
+
+    addResult( "AudioBuffer::mergeBuffers", measure<float>( [ & ]( int, int, int ) {
+        target.mergeBuffers( &source, 0, 0, .5f );
+    }, configuration, signal ));
+
+    addResult( "AudioBuffer::adjustBufferVolumes", measure<float>( [ & ]( int, int, int ) {
+        target.adjustBufferVolumes( .99f );
+    }, configuration, signal ));
+
+    // a silent buffer is the worst case, as every sample is inspected
+
+    bool isSilent = true;
+
+    addResult( "AudioBuffer::isSilent", measure<float>( [ & ]( int, int, int ) {
+        isSilent = silent.isSilent() && isSilent;
+    }, configuration, signal ));
+
+    if ( !isSilent )
+        printf( "AudioBuffer::isSilent() returned an unexpected result\n" );
+}
+
+static void writeJSON( FILE* file, const std::vector<Result>& results )
+{
+    fprintf( file, "{\n" );
+    fprintf( file, "  \"kernels\": \"%s\",\n", Kernels::getArchitectureName( Kernels::getArchitecture()));
+    fprintf( file, "  \"measuredSeconds\": %g,\n", MEASURED_SECONDS );
+    fprintf( file, "  \"results\": [\n" );
+
+    for ( size_t i = 0; i < results.size(); ++i ) {
+        const Result& result = results[ i ];
+        fprintf( file, "    { \"benchmark\": \"%s\", \"sampleType\": \"%s\", \"blockSize\": %d, \"sampleRate\": %d, "
+                 "\"channels\": %d, \"nsPerSample\": %.4f, \"realtimeFactor\": %.1f }%s\n",
+                 result.benchmark.c_str(), result.sampleType, result.blockSize, result.sampleRate, result.channels,
+                 result.nsPerSample, result.realtimeFactor, i + 1 < results.size() ? "," : "" );
+    }
+    fprintf( file, "  ]\n}\n" );
+}
+
+static void printSummary( const std::vector<Result>& results )
+{
+    printf( "DSP classes (ns/sample for %d channels at %d Hz, per block size)\n\n", SUMMARY_CHANNELS, SUMMARY_SAMPLE_RATE );
+    printf( "%-36s %7s", "benchmark", "type" );
+
+    for ( int blockSize : BLOCK_SIZES )
+        printf( " %7d", blockSize );
+
+    printf( "\n" );
+
+    // the results are listed per benchmark in order of the block sizes
+
+    for ( size_t i = 0; i < results.size(); ++i )
+    {
+        const Result& result = results[ i ];
+
+        if ( result.sampleRate != SUMMARY_SAMPLE_RATE || result.channels != SUMMARY_CHANNELS || result.blockSize != BLOCK_SIZES[ 0 ])
+            continue;
+
+        printf( "%-36s %7s", result.benchmark.c_str(), result.sampleType );
+
+        for ( const Result& other : results ) {
+            if ( other.benchmark == result.benchmark && other.sampleType == result.sampleType &&
+                 other.sampleRate == SUMMARY_SAMPLE_RATE && other.channels == SUMMARY_CHANNELS )
+                printf( " %7.2f", other.nsPerSample );
+        }
+        printf( "\n" );
+    }
+    printf( "\n" );
+}
+
+bool runClassBenchmark( const char* jsonFile )
+{
+    std::vector<Result> results;
+    float sampleRate = VST::SAMPLE_RATE;
+
+    for ( int channels : CHANNEL_COUNTS ) {
+        for ( int rate : SAMPLE_RATES ) {
+            for ( int blockSize : BLOCK_SIZES ) {
+                Configuration configuration = { blockSize, rate, channels };
+
+                measureClasses<float>( configuration, results );
+                measureClasses<double>( configuration, results );
+                measureAudioBuffer( configuration, results );
+            }
+        }
+    }
+
+    // restore the sample rate for the remaining benchmarks
+
+    VST::SAMPLE_RATE = sampleRate;
+
+    // the summary is omitted when the JSON is written to stdout (so it can be piped)
+
+    bool toStdout = jsonFile != nullptr && strcmp( jsonFile, "-" ) == 0;
+
+    if ( !toStdout )
+        printSummary( results );
+
+    if ( jsonFile == nullptr )
+        return true;
+
+    FILE* file = toStdout ? stdout : fopen( jsonFile, "w" );
+
+    if ( file == nullptr ) {
+        fprintf( stderr, "cannot write %s\n", jsonFile );
+        return false;
+    }
+    writeJSON( file, results );
+
+    return toStdout || fclose( file ) == 0;
+}
+
+}
+}
@@ -0,0 +1,136 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include <cstring>
+#include <vector>
+
+namespace Igorski {
+namespace Bench {
+
+/**
+ * compares the staged execution of RegraderProcess (each effect processes the full
+ * buffer in turn) against the fused execution (each channel is streamed through the
+ * full chain in cache sized tiles), verifying the output of both is bit-identical
+ */
+static void compareModes( bool allEffects )
+{
+    const int numChannels = 2;
+    const int tileSize    = 256; // see RegraderProcess::FUSED_TILE_SIZE
+    const int duration    = ( int ) VST::SAMPLE_RATE * 10;
+    const int blockSizes[] = { 64, 256, 1024, 4096, 8192 };
+
+    // the amount of passes over the intermediate (pre mix, post mix and ramp) buffers
+    // per sample when all effects are enabled: the pre mix copy, two pre mix effects
+    // (read + write), the delay (read pre mix, write post mix, read feedback ramp),
+    // two post mix effects (read + write) and the final mix (read post mix, read mix ramp)
+
+    const int intermediatePasses = 1 + 4 + 3 + 4 + 2;
+
+    printf( "Fused vs. staged chain processing (%d channels, %d seconds at %.0f Hz, %s)\n\n",
+            numChannels, duration / ( int ) VST::SAMPLE_RATE, VST::SAMPLE_RATE,
+            allEffects ? "all effects enabled" : "delay and static filter only" );
+    printf( "%10s %16s %16s %10s %20s %20s %10s\n",
+            "block size", "staged ns/sample", "fused ns/sample", "speedup",
+            "staged working set", "fused working set", "identical" );
+
+    for ( int blockSize : blockSizes )
+    {
+        RegraderProcess<float>* staged = new RegraderProcess<float>( numChannels, blockSize );
+        RegraderProcess<float>* fused  = new RegraderProcess<float>( numChannels, blockSize );
+
+        if ( allEffects ) {
+            enableAllEffects( staged );
+            enableAllEffects( fused );
+        } else {
+            staged->setDelayFeedback( .5f );
+            fused->setDelayFeedback( .5f );
+        }
+
+        staged->fusedProcessing = false;
+        fused->fusedProcessing  = true;
+
+        std::vector<float> input( blockSize * numChannels );
+        std::vector<float> stagedOutput( blockSize * numChannels );
+        std::vector<float> fusedOutput( blockSize * numChannels );
+
+        float* in[ numChannels ];
+        float* outStaged[ numChannels ];
+        float* outFused[ numChannels ];
+
+        for ( int c = 0; c < numChannels; ++c ) {
+            in[ c ]        = &input[ c * blockSize ];
+            outStaged[ c ] = &stagedOutput[ c * blockSize ];
+            outFused[ c ]  = &fusedOutput[ c * blockSize ];
+        }
+
+        uint32_t seed      = 1;
+        double stagedNs  = 0.0;
+        double fusedNs   = 0.0;
+        bool identical   = true;
+        uint32_t frameSize = blockSize * sizeof( float );
+
+        for ( int processed = 0; processed < duration; processed += blockSize )
+        {
+            fillNoise( input.data(), blockSize * numChannels, seed );
+
+            Clock::time_point start = Clock::now();
+            staged->process( in, outStaged, numChannels, numChannels, blockSize, frameSize );
+            stagedNs += elapsedNs( start );
+
+            start = Clock::now();
+            fused->process( in, outFused, numChannels, numChannels, blockSize, frameSize );
+            fusedNs += elapsedNs( start );
+
+            identical = identical && memcmp( stagedOutput.data(), fusedOutput.data(), stagedOutput.size() * sizeof( float )) == 0;
+        }
+
+        int processedSamples = (( duration + blockSize - 1 ) / blockSize ) * blockSize * numChannels;
+
+        // the working set of the intermediate buffers per channel (in bytes), when it exceeds
+        // the L1 data cache, each pass over the buffers is served by the slower cache levels
+
+        int stagedWorkingSet = 4 * blockSize * sizeof( float );
+        int fusedWorkingSet  = 4 * std::min( blockSize, tileSize ) * sizeof( float );
+
+        printf( "%10d %16.2f %16.2f %9.2fx %14d bytes %14d bytes %10s\n",
+                blockSize, stagedNs / processedSamples, fusedNs / processedSamples, stagedNs / fusedNs,
+                stagedWorkingSet, fusedWorkingSet, identical ? "yes" : "NO" );
+
+        delete staged;
+        delete fused;
+    }
+    printf( "\nper sample, up to %d passes (%d bytes) are made over the intermediate buffers in either mode\n\n",
+            intermediatePasses, intermediatePasses * ( int ) sizeof( float ));
+}
+
+void runFusedChainBenchmark()
+{
+    // with all effects enabled, the chain is bound by the effects computations
+    // with the effects disabled, the chain is bound by the passes over memory
+
+    compareModes( true );
+    compareModes( false );
+}
+
+}
+}
@@ -0,0 +1,137 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include <vector>
+
+namespace Igorski {
+namespace Bench {
+
+/**
+ * processes noise through the full effect chain using the currently selected
+ * kernels, returning the processing time in nanoseconds
+ */
+template <typename SampleType>
+static double runChain( int duration )
+{
+    const int numChannels = 2;
+    const int blockSize   = 512;
+
+    RegraderProcess<SampleType>* process = new RegraderProcess<SampleType>( numChannels, blockSize );
+    enableAllEffects( process );
+
+    std::vector<SampleType> buffer( blockSize * numChannels );
+    SampleType* channels[] = { &buffer[ 0 ], &buffer[ blockSize ] };
+
+    uint32_t seed = 1;
+    double ns   = 0.0;
+
+    for ( int processed = 0; processed < duration; processed += blockSize ) {
+        fillNoise( buffer.data(), blockSize * numChannels, seed );
+
+        Clock::time_point start = Clock::now();
+        process->process( channels, channels, numChannels, numChannels, blockSize, blockSize * sizeof( SampleType ));
+        ns += elapsedNs( start );
+    }
+    delete process;
+
+    return ns;
+}
+
+/**
+ * applies each of the currently selected kernels onto a block of noise,
+ * returning the processing time in nanoseconds
+ */
+template <typename SampleType>
+static double runKernels( int duration )
+{
+    const int numChannels = 2;
+    const int blockSize   = 512;
+
+    const Kernels::Table<SampleType>& kernels = Kernels::get<SampleType>();
+
+    std::vector<SampleType> frames( blockSize * numChannels );
+    std::vector<SampleType> delayed( blockSize * numChannels );
+    std::vector<SampleType> output( blockSize * numChannels );
+    std::vector<float> ramp( blockSize, .5f );
+    SampleType state[ numChannels * 4 ] = { 0 };
+    SampleType* channels[] = { &output[ 0 ], &output[ blockSize ] };
+
+    uint32_t seed = 1;
+    double ns   = 0.0;
+
+    for ( int processed = 0; processed < duration; processed += blockSize ) {
+        fillNoise( frames.data(),  blockSize * numChannels, seed );
+        fillNoise( delayed.data(), blockSize * numChannels, seed );
+
+        Clock::time_point start = Clock::now();
+
+        kernels.applyFeedback( frames.data(), delayed.data(), ramp.data(), numChannels, blockSize );
+        kernels.crush( frames.data(), blockSize * numChannels, 6, ( SampleType ) 1, ( SampleType ) 1 );
+        kernels.biquad( frames.data(), numChannels, blockSize, ( SampleType ) .2, ( SampleType ) .4, ( SampleType ) .2,
+                        ( SampleType ) -.3, ( SampleType ) .1, state, state + 2, state + 4, state + 6 );
+
+        for ( int c = 0; c < numChannels; ++c )
+            kernels.mixWetDry( channels[ c ], frames.data() + c, numChannels, delayed.data() + c, numChannels, ramp.data(), blockSize );
+
+        kernels.limit( channels, numChannels, blockSize, ( SampleType ) 1, ( SampleType ) .5,
+                       ( SampleType ) .5, ( SampleType ) .01, ( SampleType ) 1, false );
+        kernels.mix( output.data(), frames.data(), blockSize * numChannels, ( SampleType ) .5 );
+        kernels.scale( output.data(), blockSize * numChannels, ( SampleType ) .5 );
+        kernels.isZero( output.data(), blockSize * numChannels );
+
+        ns += elapsedNs( start );
+    }
+    return ns;
+}
+
+void runKernelBenchmark()
+{
+    const int duration = ( int ) VST::SAMPLE_RATE * 10;
+    double blocks = ( double ) duration / 512;
+
+    Kernels::Architecture::Type detected = Kernels::getArchitecture();
+
+    printf( "Kernels per instruction set (full chain and the kernels in isolation for 2 channels,\n" );
+    printf( "%d seconds at %.0f Hz in 512 sample blocks)\n\n",
+            duration / ( int ) VST::SAMPLE_RATE, VST::SAMPLE_RATE );
+    printf( "%12s %18s %18s %18s %18s\n", "kernels", "float us/block", "double us/block", "float kernels", "double kernels" );
+
+    for ( int i = 0; i < Kernels::Architecture::COUNT; ++i ) {
+        Kernels::Architecture::Type architecture = ( Kernels::Architecture::Type ) i;
+
+        if ( !Kernels::select( architecture ))
+            continue;
+
+        printf( "%12s %18.2f %18.2f %18.2f %18.2f\n", Kernels::getArchitectureName( architecture ),
+                runChain<float>( duration ) / blocks / 1000.0, runChain<double>( duration ) / blocks / 1000.0,
+                runKernels<float>( duration ) / blocks / 1000.0, runKernels<double>( duration ) / blocks / 1000.0 );
+    }
+    printf( "\n" );
+
+    // restore the selection for the remaining benchmarks
+
+    Kernels::select( detected );
+}
+
+}
+}
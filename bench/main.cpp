@@ -0,0 +1,56 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include <cstring>
+
+namespace Igorski {
+float VST::SAMPLE_RATE = 44100.f; // normally set by the plugin, see vst.cpp
+}
+
+using namespace Igorski;
+
+int main( int argc, char* argv[] )
+{
+    Kernels::initialize();
+
+    // when requested, only the DSP classes are benchmarked, writing their results as JSON
+    // (e.g. to compare the results of different releases)
+
+    if ( argc > 2 && strcmp( argv[ 1 ], "--json" ) == 0 )
+        return Bench::runClassBenchmark( argv[ 2 ] ) ? 0 : 1;
+
+    if ( argc > 1 ) {
+        printf( "usage: regrader-bench [--json <file>]\n" );
+        return 1;
+    }
+
+    Bench::runFusedChainBenchmark();
+    Bench::runSampleSizeBenchmark();
+    Bench::runDelayInterpolationBenchmark();
+    Bench::runDenormalBenchmark();
+    Bench::runOversamplingBenchmark();
+    Bench::runKernelBenchmark();
+    Bench::runClassBenchmark( nullptr );
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include <cmath>
+#include <vector>
+
+namespace Igorski {
+namespace Bench {
+
+/**
+ * energy of the sinusoidal component at given frequency (in Hz, an integer amount of cycles
+ * over the buffer) of given buffer of one second, calculated using the Goertzel algorithm
+ */
+static double getComponentEnergy( const std::vector<double>& buffer, int frequency )
+{
+    int length     = ( int ) buffer.size();
+    double omega   = 2.0 * VST::PI * frequency / length;
+    double coeff   = 2.0 * cos( omega );
+    double s1 = 0.0, s2 = 0.0;
+
+    for ( int i = 0; i < length; ++i ) {
+        double s0 = buffer[ i ] + coeff * s1 - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+    double power = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+
+    // a (non-DC) sinusoid is spread over its positive and negative frequency
+
+    return (( frequency == 0 ) ? power : power * 2.0 ) / length;
+}
+
+/**
+ * crushes a sine wave at given oversampling factor (applying the BitCrusher the same way
+ * RegraderProcess does) and returns the energy of all components other than the harmonics
+ * of the sine (e.g. the aliases folded back below the Nyquist frequency) relative to the
+ * energy of the sine, in dB
+ */
+static double measureAliasing( int factor )
+{
+    const int numChannels = 1;
+    const int blockSize   = 256;
+    const int sampleRate  = ( int ) VST::SAMPLE_RATE;
+    const int frequency   = 5003; // an integer frequency whose harmonics do not fold onto each other
+
+    Oversampler<double>* oversampler = new Oversampler<double>( numChannels, blockSize );
+    BitCrusher<double>* bitCrusher   = new BitCrusher<double>( .2f, 1.f, 1.f ); // 4 bits
+
+    oversampler->setFactor( factor );
+    bitCrusher->setOversamplingFactor( factor );
+
+    // render two seconds, only the second is analysed (so the filters have settled)
+
+    std::vector<double> block( blockSize );
+    std::vector<double> output;
+    int phase = 0;
+
+    while (( int ) output.size() < sampleRate * 2 ) {
+        for ( int i = 0; i < blockSize; ++i, ++phase ) {
+            block[ i ] = .9 * sin( 2.0 * VST::PI * frequency * ( phase % sampleRate ) / sampleRate );
+        }
+        double* oversampled = oversampler->upsample( block.data(), numChannels, blockSize );
+        bitCrusher->process( oversampled, numChannels, blockSize * factor );
+        oversampler->downsample( block.data(), numChannels, blockSize );
+
+        output.insert( output.end(), block.begin(), block.end() );
+    }
+    std::vector<double> analysed( output.begin() + sampleRate, output.begin() + sampleRate * 2 );
+
+    double totalEnergy = 0.0;
+    for ( double sample : analysed ) {
+        totalEnergy += sample * sample;
+    }
+
+    double harmonicEnergy = getComponentEnergy( analysed, 0 ); // the bit crusher adds a DC offset
+
+    for ( int harmonic = frequency; harmonic < sampleRate / 2; harmonic += frequency ) {
+        harmonicEnergy += getComponentEnergy( analysed, harmonic );
+    }
+    double signalEnergy = getComponentEnergy( analysed, frequency );
+    double aliasEnergy  = std::max( 1e-30, totalEnergy - harmonicEnergy );
+
+    delete oversampler;
+    delete bitCrusher;
+
+    return 10.0 * log10( aliasEnergy / signalEnergy );
+}
+
+/**
+ * processes noise through the full effect chain (with the bit crusher and decimator
+ * oversampled by given factor), returning the processing time in nanoseconds
+ */
+template <typename SampleType>
+static double runChain( int factor, int duration )
+{
+    const int numChannels = 2;
+    const int blockSize   = 512;
+
+    RegraderProcess<SampleType>* process = new RegraderProcess<SampleType>( numChannels, blockSize );
+    enableAllEffects( process );
+    process->setOversamplingFactor( factor );
+
+    std::vector<SampleType> buffer( blockSize * numChannels );
+    SampleType* channels[] = { &buffer[ 0 ], &buffer[ blockSize ] };
+
+    uint32_t seed = 1;
+    double ns   = 0.0;
+
+    for ( int processed = 0; processed < duration; processed += blockSize ) {
+        fillNoise( buffer.data(), blockSize * numChannels, seed );
+
+        Clock::time_point start = Clock::now();
+        process->process( channels, channels, numChannels, numChannels, blockSize, blockSize * sizeof( SampleType ));
+        ns += elapsedNs( start );
+    }
+    delete process;
+
+    return ns;
+}
+
+void runOversamplingBenchmark()
+{
+    const int duration = ( int ) VST::SAMPLE_RATE * 10;
+    const int factors[] = { 1, 2, 4, 8 };
+
+    printf( "Oversampling of the nonlinear stages (aliasing of a 4-bit crushed 5003 Hz sine, full chain cost\n" );
+    printf( "for 2 channels, %d seconds at %.0f Hz in 512 sample blocks)\n\n", duration / ( int ) VST::SAMPLE_RATE, VST::SAMPLE_RATE );
+    printf( "%8s %10s %12s %18s %18s\n", "factor", "latency", "aliasing dB", "float us/block", "double us/block" );
+
+    for ( int factor : factors ) {
+        Oversampler<float> oversampler( 1, 1 );
+        int latency = ( factor > 1 ) ? oversampler.getLatency( factor ) * 2 : 0;
+
+        double blocks = ( double ) duration / 512;
+
+        printf( "%8d %10d %12.1f %18.2f %18.2f\n", factor, latency, measureAliasing( factor ),
+                runChain<float>( factor, duration ) / blocks / 1000.0, runChain<double>( factor, duration ) / blocks / 1000.0 );
+    }
+    printf( "\n" );
+}
+
+}
+}
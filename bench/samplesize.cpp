@@ -0,0 +1,130 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "benchmark.h"
+#include <cmath>
+#include <vector>
+
+namespace Igorski {
+namespace Bench {
+
+/**
+ * renders the same noise signal through a RegraderProcess operating at given
+ * sample type, returning the total processing time in nanoseconds. The rendered
+ * output is collected (at double precision) so the sample types can be compared
+ */
+template <typename SampleType>
+static double render( int blockSize, int duration, bool allEffects, std::vector<double>& output )
+{
+    const int numChannels = 2;
+
+    RegraderProcess<SampleType>* process = new RegraderProcess<SampleType>( numChannels, blockSize );
+
+    if ( allEffects )
+        enableAllEffects( process );
+    else
+        process->setDelayFeedback( .5f );
+
+    std::vector<double> noise( blockSize * numChannels );
+    std::vector<SampleType> input( blockSize * numChannels );
+    std::vector<SampleType> out( blockSize * numChannels );
+
+    SampleType* in[ numChannels ];
+    SampleType* outs[ numChannels ];
+
+    for ( int c = 0; c < numChannels; ++c ) {
+        in[ c ]   = &input[ c * blockSize ];
+        outs[ c ] = &out[ c * blockSize ];
+    }
+
+    uint32_t seed      = 1;
+    double ns        = 0.0;
+    uint32_t frameSize = blockSize * sizeof( SampleType );
+
+    output.clear();
+
+    for ( int processed = 0; processed < duration; processed += blockSize )
+    {
+        // generate the noise at the highest precision so both sample types receive the same signal
+
+        fillNoise( noise.data(), blockSize * numChannels, seed );
+
+        for ( size_t i = 0; i < noise.size(); ++i )
+            input[ i ] = ( SampleType ) ( float ) noise[ i ];
+
+        Clock::time_point start = Clock::now();
+        process->process( in, outs, numChannels, numChannels, blockSize, frameSize );
+        ns += elapsedNs( start );
+
+        output.insert( output.end(), out.begin(), out.end() );
+    }
+    delete process;
+
+    return ns;
+}
+
+/**
+ * compares the throughput of the 32-bit (float) and 64-bit (double)
+ * processing paths, along with the deviation between their output
+ */
+static void compareSampleSizes( bool allEffects )
+{
+    const int numChannels = 2;
+    const int duration    = ( int ) VST::SAMPLE_RATE * 10;
+    const int blockSizes[] = { 64, 512, 4096 };
+
+    printf( "Float vs. double processing (%d channels, %d seconds at %.0f Hz, %s)\n\n",
+            numChannels, duration / ( int ) VST::SAMPLE_RATE, VST::SAMPLE_RATE,
+            allEffects ? "all effects enabled" : "delay only" );
+    printf( "%10s %16s %17s %10s %15s\n",
+            "block size", "float ns/sample", "double ns/sample", "ratio", "max deviation" );
+
+    std::vector<double> floatOutput;
+    std::vector<double> doubleOutput;
+
+    for ( int blockSize : blockSizes )
+    {
+        double floatNs  = render<float> ( blockSize, duration, allEffects, floatOutput );
+        double doubleNs = render<double>( blockSize, duration, allEffects, doubleOutput );
+
+        double maxDeviation = 0.0;
+
+        for ( size_t i = 0; i < floatOutput.size(); ++i )
+            maxDeviation = std::max( maxDeviation, fabs( floatOutput[ i ] - doubleOutput[ i ]));
+
+        double processedSamples = ( double ) floatOutput.size();
+
+        printf( "%10d %16.2f %17.2f %9.2fx %15.3g\n",
+                blockSize, floatNs / processedSamples, doubleNs / processedSamples,
+                doubleNs / floatNs, maxDeviation );
+    }
+    printf( "\n" );
+}
+
+void runSampleSizeBenchmark()
+{
+    compareSampleSizes( true );
+    compareSampleSizes( false );
+}
+
+}
+}
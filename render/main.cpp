@@ -0,0 +1,338 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "global.h"
+#include "kernels.h"
+#include "denormalguard.h"
+#include "parametermodel.h"
+#include "preset.h"
+#include "wavefile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * regrader-render applies the effect to a WAV file without a VST host, e.g.
+ *
+ * regrader-render input.wav output.wav --preset settings.vstpreset --delayMix 0.8
+ *
+ * the file is streamed through the processor in blocks of a fixed size, as a host would
+ */
+namespace Igorski {
+float VST::SAMPLE_RATE = 44100.f; // normally set by the plugin, see vst.cpp
+}
+
+using namespace Igorski;
+
+typedef std::chrono::steady_clock Clock;
+
+struct RenderOptions {
+    const char* inputFile  = nullptr;
+    const char* outputFile = nullptr;
+    int blockSize          = 512;
+    bool doublePrecision   = false;
+    bool realtimeProfile   = false;
+    double tempo           = 120.0;
+    double tailSeconds     = -1.0; // negative to render until the effect tails have decayed
+    WaveFormat format      = { 0, 0, 0, false }; // zero bit depth to use the format of the input
+};
+
+// the effect tail is rendered up until the processor is idle, but at most this many seconds
+// (as the tail of a delay with a non attenuating feedback never decays)
+
+static const double MAX_TAIL_SECONDS = 60.0;
+
+static void printUsage()
+{
+    printf( "usage: regrader-render <input.wav> <output.wav> [options]\n\n"
+            "  --preset <file>     apply a .vstpreset or a text file of \"name = value\" lines\n"
+            "  --<name> <value>    set a parameter to a normalized (0 - 1) value, see --list\n"
+            "  --list              list the parameters with their default values\n"
+            "  --block <frames>    the amount of frames processed at a time (default 512)\n"
+            "  --double            process at 64-bit precision (default is 32-bit)\n"
+            "  --realtime          use the realtime quality profile (default is the offline profile)\n"
+            "  --tempo <bpm>       the tempo the delay is synced to (default 120)\n"
+            "  --tail <seconds>    the length of the rendered effect tail (default until decayed)\n"
+            "  --format <format>   the output format: 16, 24, 32 or f32 (default is the input format)\n" );
+}
+
+static void listParameters()
+{
+    for ( int paramId = 0; paramId < kNumParameters; ++paramId )
+        printf( "  %-22s %g\n", ParameterModel::getName( paramId ), ParameterModel::getDefaultValue( paramId ));
+}
+
+static bool parseFormat( const char* value, WaveFormat& format )
+{
+    format.isFloat = !strcmp( value, "f32" );
+
+    if ( format.isFloat )
+        format.bitDepth = 32;
+    else if ( !strcmp( value, "16" ) || !strcmp( value, "24" ) || !strcmp( value, "32" ))
+        format.bitDepth = atoi( value );
+    else
+        return false;
+
+    return true;
+}
+
+template <typename SampleType>
+static int render( const RenderOptions& options, const float* values, WaveReader& reader )
+{
+    WaveFormat inputFormat  = reader.getFormat();
+    WaveFormat outputFormat = inputFormat;
+
+    if ( options.format.bitDepth > 0 ) {
+        outputFormat.bitDepth = options.format.bitDepth;
+        outputFormat.isFloat  = options.format.isFloat;
+    }
+
+    WaveWriter writer;
+
+    if ( !writer.open( options.outputFile, outputFormat )) {
+        fprintf( stderr, "%s\n", writer.getError().c_str());
+        return 1;
+    }
+
+    // the processor is configured as the plugin does in Regrader::setupProcessing()
+
+    VST::SAMPLE_RATE = ( float ) inputFormat.sampleRate;
+
+    int amountOfChannels = inputFormat.amountOfChannels;
+    int blockSize        = options.blockSize;
+
+    RegraderProcess<SampleType>* process = new RegraderProcess<SampleType>( amountOfChannels, blockSize );
+    process->updateSampleRate();
+
+    ParameterModel::apply( values, process, options.realtimeProfile ? QualityProfiles::REALTIME : QualityProfiles::OFFLINE );
+    process->setTempo( options.tempo, 4, 4 );
+
+    bool bypass = values[ kBypassId ] >= .5f;
+
+    std::vector<std::vector<SampleType>> inputs ( amountOfChannels, std::vector<SampleType>( blockSize, 0 ));
+    std::vector<std::vector<SampleType>> outputs( amountOfChannels, std::vector<SampleType>( blockSize, 0 ));
+    std::vector<SampleType*> in, out;
+
+    for ( int c = 0; c < amountOfChannels; ++c ) {
+        in.push_back ( inputs [ c ].data());
+        out.push_back( outputs[ c ].data());
+    }
+
+    // the output lags the input by the latency of the processor, the leading latency frames
+    // are omitted from the output and the input is followed by as many frames of silence
+
+    int latency          = bypass ? 0 : process->getLatency();
+    int64_t inputLength  = reader.getLength();
+    int64_t maxTail      = ( int64_t )( std::min( options.tailSeconds < 0 ? MAX_TAIL_SECONDS : options.tailSeconds, MAX_TAIL_SECONDS ) * inputFormat.sampleRate );
+    int64_t outputLength = bypass ? inputLength : inputLength + maxTail;
+    int64_t renderLength = outputLength + latency;
+
+    int64_t position = 0;
+    int64_t written  = 0;
+    double processNs = 0.0;
+    bool success     = true;
+
+    Clock::time_point renderStart = Clock::now();
+
+    while ( position < renderLength && success )
+    {
+        int frames     = ( int ) std::min(( int64_t ) blockSize, renderLength - position );
+        int readFrames = reader.read( in.data(), frames );
+
+        for ( int c = 0; c < amountOfChannels; ++c )
+            std::fill( inputs[ c ].begin() + readFrames, inputs[ c ].begin() + frames, ( SampleType ) 0 );
+
+        // when rendering the tail up until it has decayed, stop once the processor has fallen idle
+
+        if ( readFrames == 0 && options.tailSeconds < 0 && process->isIdle() && position >= inputLength + latency )
+            break;
+
+        Clock::time_point processStart = Clock::now();
+
+        if ( bypass ) {
+            for ( int c = 0; c < amountOfChannels; ++c )
+                std::copy( inputs[ c ].begin(), inputs[ c ].begin() + frames, outputs[ c ].begin());
+        } else {
+            DenormalGuard denormalGuard;
+            process->process( in.data(), out.data(), amountOfChannels, amountOfChannels, frames, frames * sizeof( SampleType ));
+        }
+        processNs += ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - processStart ).count();
+
+        // omit the frames output during the latency of the processor
+
+        int skip = ( int ) std::max(( int64_t ) 0, std::min(( int64_t ) frames, latency - position ));
+
+        if ( skip < frames ) {
+            std::vector<SampleType*> offsetOutputs( out );
+
+            for ( SampleType*& channel : offsetOutputs )
+                channel += skip;
+
+            success  = writer.write( offsetOutputs.data(), frames - skip );
+            written += frames - skip;
+        }
+        position += frames;
+    }
+
+    double totalNs = ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - renderStart ).count();
+
+    delete process;
+
+    if ( !writer.close() || !success ) {
+        fprintf( stderr, "%s\n", writer.getError().c_str());
+        return 1;
+    }
+
+    // the realtime factor is the duration of the rendered audio relative to the time it took to render
+    // (the processing factor excludes the time spent reading and writing the files)
+
+    double audioSeconds = ( double ) written / inputFormat.sampleRate;
+
+    printf( "rendered %.2f seconds of %d channel audio at %d Hz (%d-bit %s, latency %d frames)\n",
+            audioSeconds, amountOfChannels, inputFormat.sampleRate,
+            ( int ) sizeof( SampleType ) * 8, bypass ? "bypassed" : "processing", latency );
+    printf( "realtime factor: %.1fx (total), %.1fx (processing only)\n",
+            audioSeconds / std::max( totalNs * 1e-9, 1e-9 ), audioSeconds / std::max( processNs * 1e-9, 1e-9 ));
+
+    return 0;
+}
+
+int main( int argc, char* argv[] )
+{
+    RenderOptions options;
+    float values[ kNumParameters ];
+    ParameterModel::getDefaultValues( values );
+
+    // the parameters set on the command line take precedence over the preset, regardless
+    // of their position, as such these are applied after the preset has been loaded
+
+    const char* presetFile = nullptr;
+    std::vector<std::pair<int, float>> parameters;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        const char* arg   = argv[ i ];
+        const char* value = i + 1 < argc ? argv[ i + 1 ] : nullptr;
+
+        if ( strncmp( arg, "--", 2 ) != 0 ) {
+            if ( options.inputFile == nullptr )
+                options.inputFile = arg;
+            else if ( options.outputFile == nullptr )
+                options.outputFile = arg;
+            else {
+                printUsage();
+                return 1;
+            }
+            continue;
+        }
+
+        const char* name = arg + 2;
+
+        if ( !strcmp( name, "list" )) {
+            listParameters();
+            return 0;
+        }
+        if ( !strcmp( name, "help" )) {
+            printUsage();
+            return 0;
+        }
+        if ( !strcmp( name, "double" )) {
+            options.doublePrecision = true;
+            continue;
+        }
+        if ( !strcmp( name, "realtime" )) {
+            options.realtimeProfile = true;
+            continue;
+        }
+
+        // all remaining options have a value
+
+        if ( value == nullptr ) {
+            fprintf( stderr, "missing value for %s\n", arg );
+            return 1;
+        }
+        ++i;
+
+        bool isValid = true;
+
+        if ( !strcmp( name, "preset" ))
+            presetFile = value;
+        else if ( !strcmp( name, "block" ))
+            isValid = ( options.blockSize = atoi( value )) > 0;
+        else if ( !strcmp( name, "tempo" ))
+            isValid = ( options.tempo = atof( value )) > 0.0;
+        else if ( !strcmp( name, "tail" ))
+            isValid = ( options.tailSeconds = atof( value )) >= 0.0;
+        else if ( !strcmp( name, "format" ))
+            isValid = parseFormat( value, options.format );
+        else {
+            int paramId = ParameterModel::getId( name );
+            char* end   = nullptr;
+            float parsed = strtof( value, &end );
+
+            if ( paramId < 0 ) {
+                fprintf( stderr, "unknown option %s (see --list for the parameter names)\n", arg );
+                return 1;
+            }
+            isValid = *end == '\0' && parsed >= 0.f && parsed <= 1.f;
+            parameters.push_back({ paramId, parsed });
+        }
+
+        if ( !isValid ) {
+            fprintf( stderr, "invalid value \"%s\" for %s\n", value, arg );
+            return 1;
+        }
+    }
+
+    if ( options.inputFile == nullptr || options.outputFile == nullptr ) {
+        printUsage();
+        return 1;
+    }
+
+    std::string error;
+
+    if ( presetFile != nullptr && !Preset::load( presetFile, values, error )) {
+        fprintf( stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    for ( const std::pair<int, float>& parameter : parameters )
+        values[ parameter.first ] = parameter.second;
+
+    WaveReader reader;
+
+    if ( !reader.open( options.inputFile )) {
+        fprintf( stderr, "%s\n", reader.getError().c_str());
+        return 1;
+    }
+
+    Kernels::initialize();
+
+    if ( options.doublePrecision )
+        return render<double>( options, values, reader );
+
+    return render<float>( options, values, reader );
+}
@@ -0,0 +1,183 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "preset.h"
+#include "parametermodel.h"
+#include <algorithm>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+namespace Igorski {
+namespace Preset {
+
+static int64_t readInt( const unsigned char* bytes, int size )
+{
+    uint64_t value = 0;
+
+    for ( int i = size - 1; i >= 0; --i )
+        value = ( value << 8 ) | bytes[ i ];
+
+    return ( int64_t ) value;
+}
+
+static std::string trim( const std::string& text )
+{
+    size_t start = text.find_first_not_of( " \t\r\n" );
+    size_t end   = text.find_last_not_of( " \t\r\n" );
+
+    return start == std::string::npos ? "" : text.substr( start, end - start + 1 );
+}
+
+// a .vstpreset file consists of a header ('VST3', version, class id and the offset
+// to the chunk list) followed by the chunks, where 'Comp' holds the processor state
+
+static bool loadVstPreset( const std::vector<unsigned char>& file, float* values, std::string& error )
+{
+    const size_t HEADER_SIZE = 48;
+
+    if ( file.size() < HEADER_SIZE ) {
+        error = "truncated .vstpreset header";
+        return false;
+    }
+
+    int64_t listOffset = readInt( &file[ 40 ], 8 );
+
+    if ( listOffset < ( int64_t ) HEADER_SIZE || listOffset + 8 > ( int64_t ) file.size() || memcmp( &file[ listOffset ], "List", 4 ) != 0 ) {
+        error = "missing chunk list in .vstpreset";
+        return false;
+    }
+
+    int64_t amountOfChunks = readInt( &file[ listOffset + 4 ], 4 );
+
+    for ( int64_t i = 0; i < amountOfChunks; ++i )
+    {
+        size_t entry = ( size_t )( listOffset + 8 + i * 20 );
+
+        if ( entry + 20 > file.size())
+            break;
+
+        if ( memcmp( &file[ entry ], "Comp", 4 ) != 0 )
+            continue;
+
+        int64_t offset = readInt( &file[ entry + 4 ],  8 );
+        int64_t size   = readInt( &file[ entry + 12 ], 8 );
+
+        if ( offset < 0 || size < 0 || offset + size > ( int64_t ) file.size()) {
+            error = "invalid component state in .vstpreset";
+            return false;
+        }
+
+        // the state lists the values in order of the parameter ids (see Regrader::getState())
+        // states saved by previous versions can hold fewer parameters, these keep their value
+
+        for ( int paramId = 0; paramId < kNumParameters && ( paramId + 1 ) * 4 <= size; ++paramId )
+        {
+            const unsigned char* bytes = &file[ offset + paramId * 4 ];
+
+            if ( paramId == kBypassId ) {
+                values[ paramId ] = readInt( bytes, 4 ) != 0 ? 1.f : 0.f;
+            } else {
+                uint32_t bits = ( uint32_t ) readInt( bytes, 4 );
+                memcpy( &values[ paramId ], &bits, 4 );
+            }
+        }
+        return true;
+    }
+    error = "no component state in .vstpreset";
+    return false;
+}
+
+static bool loadText( const std::vector<unsigned char>& file, float* values, std::string& error )
+{
+    std::string text( file.begin(), file.end());
+    size_t lineStart = 0;
+    int lineNumber = 0;
+
+    while ( lineStart < text.size())
+    {
+        size_t lineEnd = text.find( '\n', lineStart );
+
+        if ( lineEnd == std::string::npos )
+            lineEnd = text.size();
+
+        std::string line = text.substr( lineStart, lineEnd - lineStart );
+        lineStart = lineEnd + 1;
+        ++lineNumber;
+
+        size_t comment = line.find( '#' );
+
+        if ( comment != std::string::npos )
+            line = line.substr( 0, comment );
+
+        line = trim( line );
+
+        if ( line.empty())
+            continue;
+
+        size_t separator  = line.find( '=' );
+        std::string name  = trim( line.substr( 0, separator ));
+        std::string value = separator == std::string::npos ? "" : trim( line.substr( separator + 1 ));
+
+        int paramId = ParameterModel::getId( name.c_str());
+        char* end   = nullptr;
+        float parsed = strtof( value.c_str(), &end );
+
+        if ( paramId < 0 || value.empty() || *end != '\0' ) {
+            error = "invalid preset line " + std::to_string( lineNumber ) + ": " + line;
+            return false;
+        }
+        values[ paramId ] = std::min( 1.f, std::max( 0.f, parsed ));
+    }
+    return true;
+}
+
+/* public methods */
+
+bool load( const char* filename, float* values, std::string& error )
+{
+    FILE* file = fopen( filename, "rb" );
+
+    if ( file == nullptr ) {
+        error = std::string( "cannot open " ) + filename;
+        return false;
+    }
+
+    std::vector<unsigned char> contents;
+    unsigned char chunk[ 4096 ];
+    size_t read;
+
+    while (( read = fread( chunk, 1, sizeof( chunk ), file )) > 0 )
+        contents.insert( contents.end(), chunk, chunk + read );
+
+    fclose( file );
+
+    if ( contents.size() >= 4 && memcmp( contents.data(), "VST3", 4 ) == 0 )
+        return loadVstPreset( contents, values, error );
+
+    return loadText( contents, values, error );
+}
+
+}
+}
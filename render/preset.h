@@ -1,7 +1,7 @@
 /**
  * The MIT License (MIT)
  *
- * Copyright (c) 2018 Igor Zinken - https://www.igorski.nl
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy of
  * this software and associated documentation files (the "Software"), to deal in
@@ -20,56 +20,30 @@
  * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
-#ifndef __UTIL_HEADER__
-#define __UTIL_HEADER__
+#ifndef __PRESET_H_INCLUDED__
+#define __PRESET_H_INCLUDED__
 
-#include <fstream>
 #include <string>
-#include <time.h>
 
+/**
+ * loads the parameter values of a preset, either a .vstpreset file saved by a host
+ * (containing the plugin state as written by Regrader::getState()) or a text file
+ * listing parameters by name, one per line, e.g.:
+ *
+ * # a comment
+ * delayTime = 0.25
+ * filterCutoff = 0.8
+ *
+ * all values are normalized (0 - 1 range), see ParameterModel for the parameter names
+ */
 namespace Igorski {
-namespace Util {
-
-    /**
-     * Convenience method to log a message to a file
-     * multiple messages can be written to the same file (are
-     * separated by a new line)
-     *
-     * This should be used for debugging purposes only
-     */
-    void log( const char* message, const char* filename )
-    {
-        std::ofstream out;
-
-        char buff[20];
-        struct tm *sTm;
-
-        time_t now = time( 0 );
-        sTm        = gmtime( &now );
-
-        strftime( buff, sizeof( buff ), "%Y-%m-%d %H:%M:%S", sTm );
-
-        out.open( filename, std::ios_base::app );
-        out << buff << " " << message << "\n";
-
-        out.close();
-    }
-
-    void log( std::string message, const char* filename )
-    {
-        log( message.c_str(), filename );
-    }
-
-    void log( float value, const char* filename )
-    {
-        log( std::to_string( value ), filename );
-    }
+namespace Preset {
 
-    void log( int value, const char* filename )
-    {
-        log( std::to_string( value ), filename );
-    }
+    // apply the preset in given file onto given list of kNumParameters values (parameters
+    // not specified by the preset keep their value). Returns false and describes the
+    // problem in given error when the file cannot be read
 
+    bool load( const char* filename, float* values, std::string& error );
 }
 }
 
@@ -0,0 +1,414 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "wavefile.h"
+#include <algorithm>
+#include <cmath>
+#include <string.h>
+
+namespace Igorski {
+
+// WAV files are little endian regardless of the platform
+
+static uint32_t readUint32( const unsigned char* bytes )
+{
+    return ( uint32_t ) bytes[ 0 ] | (( uint32_t ) bytes[ 1 ] << 8 ) | (( uint32_t ) bytes[ 2 ] << 16 ) | (( uint32_t ) bytes[ 3 ] << 24 );
+}
+
+static uint16_t readUint16( const unsigned char* bytes )
+{
+    return ( uint16_t )( bytes[ 0 ] | ( bytes[ 1 ] << 8 ));
+}
+
+static void writeUint32( unsigned char* bytes, uint32_t value )
+{
+    bytes[ 0 ] = value & 0xFF;
+    bytes[ 1 ] = ( value >> 8 )  & 0xFF;
+    bytes[ 2 ] = ( value >> 16 ) & 0xFF;
+    bytes[ 3 ] = ( value >> 24 ) & 0xFF;
+}
+
+static void writeUint16( unsigned char* bytes, uint16_t value )
+{
+    bytes[ 0 ] = value & 0xFF;
+    bytes[ 1 ] = ( value >> 8 ) & 0xFF;
+}
+
+static const uint16_t FORMAT_PCM        = 1;
+static const uint16_t FORMAT_FLOAT      = 3;
+static const uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+static const int HEADER_SIZE = 44;
+
+static int getBytesPerSample( const WaveFormat& format )
+{
+    return format.bitDepth / 8;
+}
+
+static bool isSupported( const WaveFormat& format )
+{
+    if ( format.amountOfChannels < 1 || format.sampleRate < 1 )
+        return false;
+
+    if ( format.isFloat )
+        return format.bitDepth == 32 || format.bitDepth == 64;
+
+    return format.bitDepth == 8 || format.bitDepth == 16 || format.bitDepth == 24 || format.bitDepth == 32;
+}
+
+/* WaveReader */
+
+WaveReader::WaveReader()
+{
+    _file     = nullptr;
+    _format   = { 0, 0, 0, false };
+    _length   = 0;
+    _position = 0;
+}
+
+WaveReader::~WaveReader()
+{
+    close();
+}
+
+bool WaveReader::open( const char* filename )
+{
+    close();
+
+    _file = fopen( filename, "rb" );
+
+    if ( _file == nullptr ) {
+        _error = std::string( "cannot open " ) + filename;
+        return false;
+    }
+
+    unsigned char header[ 12 ];
+
+    if ( fread( header, 1, 12, _file ) != 12 || memcmp( header, "RIFF", 4 ) != 0 || memcmp( header + 8, "WAVE", 4 ) != 0 ) {
+        _error = std::string( filename ) + " is not a WAV file";
+        close();
+        return false;
+    }
+
+    bool hasFormat = false;
+    unsigned char chunkHeader[ 8 ];
+
+    // walk the chunks up until the audio data
+
+    while ( fread( chunkHeader, 1, 8, _file ) == 8 )
+    {
+        uint32_t chunkSize = readUint32( chunkHeader + 4 );
+
+        if ( memcmp( chunkHeader, "fmt ", 4 ) == 0 )
+        {
+            std::vector<unsigned char> chunk( std::max( chunkSize, ( uint32_t ) 40 ), 0 );
+
+            if ( chunkSize < 16 || fread( chunk.data(), 1, chunkSize, _file ) != chunkSize )
+                break;
+
+            uint16_t formatTag = readUint16( &chunk[ 0 ]);
+
+            // the extensible format specifies the actual format in its sub format GUID
+
+            if ( formatTag == FORMAT_EXTENSIBLE && chunkSize >= 40 )
+                formatTag = readUint16( &chunk[ 24 ]);
+
+            _format.amountOfChannels = readUint16( &chunk[ 2 ]);
+            _format.sampleRate       = ( int ) readUint32( &chunk[ 4 ]);
+            _format.bitDepth         = readUint16( &chunk[ 14 ]);
+            _format.isFloat          = formatTag == FORMAT_FLOAT;
+
+            if (( formatTag != FORMAT_PCM && formatTag != FORMAT_FLOAT ) || !isSupported( _format )) {
+                _error = std::string( filename ) + " has an unsupported sample format";
+                close();
+                return false;
+            }
+            hasFormat = true;
+
+            if ( chunkSize % 2 )
+                fseek( _file, 1, SEEK_CUR );
+        }
+        else if ( memcmp( chunkHeader, "data", 4 ) == 0 && hasFormat )
+        {
+            int frameSize = getBytesPerSample( _format ) * _format.amountOfChannels;
+
+            // a streamed file can have an unspecified data size, in which case the data lasts until the end of the file
+
+            if ( chunkSize == 0 || chunkSize == 0xFFFFFFFF ) {
+                long dataStart = ftell( _file );
+                fseek( _file, 0, SEEK_END );
+                chunkSize = ( uint32_t )( ftell( _file ) - dataStart );
+                fseek( _file, dataStart, SEEK_SET );
+            }
+            _length = chunkSize / frameSize;
+            return true;
+        }
+        else {
+            fseek( _file, chunkSize + ( chunkSize % 2 ), SEEK_CUR );
+        }
+    }
+    _error = std::string( filename ) + " contains no audio data";
+    close();
+
+    return false;
+}
+
+void WaveReader::close()
+{
+    if ( _file != nullptr )
+        fclose( _file );
+
+    _file     = nullptr;
+    _length   = 0;
+    _position = 0;
+}
+
+int WaveReader::read( float** channels, int amountOfFrames )
+{
+    return readFrames( channels, amountOfFrames );
+}
+
+int WaveReader::read( double** channels, int amountOfFrames )
+{
+    return readFrames( channels, amountOfFrames );
+}
+
+template <typename SampleType>
+int WaveReader::readFrames( SampleType** channels, int amountOfFrames )
+{
+    if ( _file == nullptr )
+        return 0;
+
+    int bytesPerSample = getBytesPerSample( _format );
+    int frameSize      = bytesPerSample * _format.amountOfChannels;
+
+    amountOfFrames = ( int ) std::min(( int64_t ) amountOfFrames, _length - _position );
+    _buffer.resize(( size_t ) std::max( amountOfFrames, 0 ) * frameSize );
+
+    int readFrames = ( int )( fread( _buffer.data(), frameSize, amountOfFrames, _file ));
+    _position += readFrames;
+
+    for ( int i = 0; i < readFrames; ++i )
+    {
+        const unsigned char* frame = &_buffer[ i * frameSize ];
+
+        for ( int c = 0; c < _format.amountOfChannels; ++c )
+        {
+            const unsigned char* bytes = frame + c * bytesPerSample;
+            double sample = 0.0;
+
+            if ( _format.isFloat ) {
+                if ( bytesPerSample == 4 ) {
+                    uint32_t bits = readUint32( bytes );
+                    float value;
+                    memcpy( &value, &bits, 4 );
+                    sample = value;
+                } else {
+                    uint64_t bits = ( uint64_t ) readUint32( bytes ) | (( uint64_t ) readUint32( bytes + 4 ) << 32 );
+                    memcpy( &sample, &bits, 8 );
+                }
+            }
+            else switch ( bytesPerSample ) {
+                case 1: // 8-bit samples are unsigned
+                    sample = ( bytes[ 0 ] - 128 ) / 128.0;
+                    break;
+                case 2:
+                    sample = ( int16_t ) readUint16( bytes ) / 32768.0;
+                    break;
+                case 3:
+                    sample = ( int32_t )(( uint32_t ) bytes[ 0 ] << 8 | ( uint32_t ) bytes[ 1 ] << 16 | ( uint32_t ) bytes[ 2 ] << 24 ) / 2147483648.0;
+                    break;
+                case 4:
+                    sample = ( int32_t ) readUint32( bytes ) / 2147483648.0;
+                    break;
+            }
+            channels[ c ][ i ] = ( SampleType ) sample;
+        }
+    }
+    return readFrames;
+}
+
+/* WaveWriter */
+
+WaveWriter::WaveWriter()
+{
+    _file   = nullptr;
+    _format = { 0, 0, 0, false };
+    _length = 0;
+}
+
+WaveWriter::~WaveWriter()
+{
+    close();
+}
+
+bool WaveWriter::open( const char* filename, const WaveFormat& format )
+{
+    close();
+
+    if ( !isSupported( format )) {
+        _error = "unsupported output sample format";
+        return false;
+    }
+
+    _file = fopen( filename, "wb" );
+
+    if ( _file == nullptr ) {
+        _error = std::string( "cannot create " ) + filename;
+        return false;
+    }
+    _format = format;
+    _length = 0;
+
+    // the header is written with the (yet unknown) data size, which is updated when closing
+
+    return writeHeader();
+}
+
+bool WaveWriter::close()
+{
+    if ( _file == nullptr )
+        return true;
+
+    bool success = fseek( _file, 0, SEEK_SET ) == 0 && writeHeader();
+
+    success = fclose( _file ) == 0 && success;
+    _file   = nullptr;
+
+    return success;
+}
+
+bool WaveWriter::write( float** channels, int amountOfFrames )
+{
+    return writeFrames( channels, amountOfFrames );
+}
+
+bool WaveWriter::write( double** channels, int amountOfFrames )
+{
+    return writeFrames( channels, amountOfFrames );
+}
+
+template <typename SampleType>
+bool WaveWriter::writeFrames( SampleType** channels, int amountOfFrames )
+{
+    if ( _file == nullptr )
+        return false;
+
+    int bytesPerSample = getBytesPerSample( _format );
+    int frameSize      = bytesPerSample * _format.amountOfChannels;
+
+    // the data chunk size is a 32-bit value
+
+    if (( _length + amountOfFrames ) * frameSize > 0xFFFFFFFF - HEADER_SIZE ) {
+        _error = "the output exceeds the maximum size of a WAV file";
+        return false;
+    }
+
+    _buffer.resize(( size_t ) amountOfFrames * frameSize );
+
+    for ( int i = 0; i < amountOfFrames; ++i )
+    {
+        unsigned char* frame = &_buffer[ i * frameSize ];
+
+        for ( int c = 0; c < _format.amountOfChannels; ++c )
+        {
+            unsigned char* bytes = frame + c * bytesPerSample;
+            double sample = ( double ) channels[ c ][ i ];
+
+            if ( _format.isFloat ) {
+                if ( bytesPerSample == 4 ) {
+                    float value = ( float ) sample;
+                    uint32_t bits;
+                    memcpy( &bits, &value, 4 );
+                    writeUint32( bytes, bits );
+                } else {
+                    uint64_t bits;
+                    memcpy( &bits, &sample, 8 );
+                    writeUint32( bytes, ( uint32_t ) bits );
+                    writeUint32( bytes + 4, ( uint32_t )( bits >> 32 ));
+                }
+                continue;
+            }
+
+            sample = std::max( -1.0, std::min( 1.0, sample ));
+
+            switch ( bytesPerSample ) {
+                case 1:
+                    bytes[ 0 ] = ( unsigned char )( std::min( 255L, std::lround( sample * 128.0 ) + 128 ));
+                    break;
+                case 2:
+                    writeUint16( bytes, ( uint16_t )( int16_t ) std::min( 32767L, std::lround( sample * 32768.0 )));
+                    break;
+                case 3: {
+                    int32_t value = ( int32_t ) std::min( 8388607L, std::lround( sample * 8388608.0 ));
+                    bytes[ 0 ] = value & 0xFF;
+                    bytes[ 1 ] = ( value >> 8 )  & 0xFF;
+                    bytes[ 2 ] = ( value >> 16 ) & 0xFF;
+                    break;
+                }
+                case 4:
+                    writeUint32( bytes, ( uint32_t )( int32_t ) std::min( 2147483647LL, std::llround( sample * 2147483648.0 )));
+                    break;
+            }
+        }
+    }
+
+    if ( fwrite( _buffer.data(), frameSize, amountOfFrames, _file ) != ( size_t ) amountOfFrames ) {
+        _error = "cannot write the output file";
+        return false;
+    }
+    _length += amountOfFrames;
+
+    return true;
+}
+
+bool WaveWriter::writeHeader()
+{
+    int bytesPerSample = getBytesPerSample( _format );
+    uint32_t dataSize  = ( uint32_t )( _length * bytesPerSample * _format.amountOfChannels );
+
+    unsigned char header[ HEADER_SIZE ];
+
+    memcpy( header, "RIFF", 4 );
+    writeUint32( header + 4, HEADER_SIZE - 8 + dataSize );
+    memcpy( header + 8, "WAVEfmt ", 8 );
+    writeUint32( header + 16, 16 );
+    writeUint16( header + 20, _format.isFloat ? FORMAT_FLOAT : FORMAT_PCM );
+    writeUint16( header + 22, ( uint16_t ) _format.amountOfChannels );
+    writeUint32( header + 24, ( uint32_t ) _format.sampleRate );
+    writeUint32( header + 28, ( uint32_t )( _format.sampleRate * bytesPerSample * _format.amountOfChannels ));
+    writeUint16( header + 32, ( uint16_t )( bytesPerSample * _format.amountOfChannels ));
+    writeUint16( header + 34, ( uint16_t ) _format.bitDepth );
+    memcpy( header + 36, "data", 4 );
+    writeUint32( header + 40, dataSize );
+
+    if ( fwrite( header, 1, HEADER_SIZE, _file ) != HEADER_SIZE ) {
+        _error = "cannot write the output file";
+        return false;
+    }
+
+    // continue writing the data after the header
+
+    return fseek( _file, 0, SEEK_END ) == 0;
+}
+
+}
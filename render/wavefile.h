@@ -0,0 +1,117 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __WAVEFILE_H_INCLUDED__
+#define __WAVEFILE_H_INCLUDED__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * streaming reader and writer of WAV files (PCM 8, 16, 24 and 32-bit integer
+ * or 32 and 64-bit floating point) in blocks of non-interleaved frames
+ */
+namespace Igorski {
+
+struct WaveFormat {
+    int amountOfChannels;
+    int sampleRate;
+    int bitDepth;
+    bool isFloat;
+};
+
+class WaveReader
+{
+    public:
+        WaveReader();
+        ~WaveReader();
+
+        // open given file, returns false when it cannot be read (see getError())
+
+        bool open( const char* filename );
+        void close();
+
+        const WaveFormat& getFormat() { return _format; }
+
+        // the amount of frames in the file
+
+        int64_t getLength() { return _length; }
+
+        // read up to given amount of frames into given channel buffers (one for each channel of the file)
+        // returns the amount of frames read, which is less than requested once the end of the file is reached
+
+        int read( float** channels, int amountOfFrames );
+        int read( double** channels, int amountOfFrames );
+
+        const std::string& getError() { return _error; }
+
+    private:
+        template <typename SampleType>
+        int readFrames( SampleType** channels, int amountOfFrames );
+
+        FILE* _file;
+        WaveFormat _format;
+        int64_t _length;
+        int64_t _position;
+        std::vector<unsigned char> _buffer;
+        std::string _error;
+};
+
+class WaveWriter
+{
+    public:
+        WaveWriter();
+        ~WaveWriter();
+
+        // create given file, returns false when it cannot be written (see getError())
+
+        bool open( const char* filename, const WaveFormat& format );
+
+        // finalize the file (its header is updated with the amount of written frames)
+
+        bool close();
+
+        // write given amount of frames from given channel buffers (one for each channel of the format)
+        // the samples are clipped to the -1 to +1 range when writing integer formats
+
+        bool write( float** channels, int amountOfFrames );
+        bool write( double** channels, int amountOfFrames );
+
+        const std::string& getError() { return _error; }
+
+    private:
+        template <typename SampleType>
+        bool writeFrames( SampleType** channels, int amountOfFrames );
+
+        bool writeHeader();
+
+        FILE* _file;
+        WaveFormat _format;
+        int64_t _length;
+        std::vector<unsigned char> _buffer;
+        std::string _error;
+};
+}
+
+#endif
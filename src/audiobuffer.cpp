@@ -21,6 +21,7 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "audiobuffer.h"
+#include "kernels.h"
 #include <algorithm>
 #include <string.h>
 
@@ -59,9 +60,11 @@ float* AudioBuffer::getBufferForChannel( int aChannelNum )
 
 int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWriteOffset, float aMixVolume )
 {
-    if ( aBuffer == 0 || aWriteOffset >= bufferSize )
+    if ( aBuffer == 0 || aWriteOffset >= bufferSize || aBuffer->bufferSize <= 0 )
         return 0;
 
+    const Igorski::Kernels::Table<float>& kernels = Igorski::Kernels::get<float>();
+
     int sourceLength     = aBuffer->bufferSize;
     int maxSourceChannel = aBuffer->amountOfChannels - 1;
     int writeLength      = bufferSize;
@@ -83,7 +86,9 @@ int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWrite
         float* srcBuffer    = aBuffer->getBufferForChannel( c );
         float* targetBuffer = getBufferForChannel( c );
 
-        for ( int i = aWriteOffset, r = aReadOffset; i < maxWriteOffset; ++i, ++r )
+        // mix in runs that do not cross the end of the source buffer
+
+        for ( int i = aWriteOffset, r = aReadOffset; i < maxWriteOffset; )
         {
             if ( r >= sourceLength )
             {
@@ -92,8 +97,13 @@ int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWrite
                 else
                     break;
             }
-            targetBuffer[ i ] += ( srcBuffer[ r ] * aMixVolume );
-            ++writtenSamples;
+            int length = std::min( maxWriteOffset - i, sourceLength - r );
+
+            kernels.mix( targetBuffer + i, srcBuffer + r, length, aMixVolume );
+
+            i += length;
+            r += length;
+            writtenSamples += length;
         }
     }
     // return the amount of samples written (per buffer)
@@ -113,25 +123,20 @@ void AudioBuffer::silenceBuffers()
 
 void AudioBuffer::adjustBufferVolumes( float amp )
 {
-    for ( int i = 0; i < amountOfChannels; ++i )
-    {
-        float* buffer = getBufferForChannel( i );
+    const Igorski::Kernels::Table<float>& kernels = Igorski::Kernels::get<float>();
 
-        for ( int j = 0; j < bufferSize; ++j )
-            buffer[ j ] *= amp;
-    }
+    for ( int i = 0; i < amountOfChannels; ++i )
+        kernels.scale( getBufferForChannel( i ), bufferSize, amp );
 }
 
 bool AudioBuffer::isSilent()
 {
+    const Igorski::Kernels::Table<float>& kernels = Igorski::Kernels::get<float>();
+
     for ( int i = 0; i < amountOfChannels; ++i )
     {
-        float* buffer = getBufferForChannel( i );
-        for ( int j = 0; j < bufferSize; ++j )
-        {
-            if ( buffer[ j ] != 0.f )
-                return false;
-        }
+        if ( !kernels.isZero( getBufferForChannel( i ), bufferSize ))
+            return false;
     }
     return true;
 }
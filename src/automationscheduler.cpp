@@ -0,0 +1,163 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "automationscheduler.h"
+#include <algorithm>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+AutomationScheduler::AutomationScheduler()
+{
+    _numEvents  = 0;
+    _eventIndex = 0;
+    _numSamples = 0;
+    _position   = 0;
+    _flushed    = true;
+}
+
+AutomationScheduler::~AutomationScheduler()
+{
+    // nowt...
+}
+
+/* public methods */
+
+void AutomationScheduler::schedule( IParameterChanges* paramChanges, int32 numSamples )
+{
+    _numEvents  = 0;
+    _eventIndex = 0;
+    _numSamples = std::max( 0, numSamples );
+    _position   = 0;
+    _flushed    = false;
+
+    if ( paramChanges == nullptr )
+        return;
+
+    int32 numParamsChanged = paramChanges->getParameterCount();
+
+    // first pass: the last point of each queue defines the parameters value for
+    // the remainder of the block, these must be applied even when the pool overflows
+
+    for ( int32 i = 0; i < numParamsChanged && _numEvents < MAX_EVENTS; ++i )
+    {
+        IParamValueQueue* paramQueue = paramChanges->getParameterData( i );
+        if ( paramQueue && paramQueue->getPointCount() > 0 )
+            addEvent( paramQueue, paramQueue->getPointCount() - 1, i * MAX_EVENTS + MAX_EVENTS - 1 );
+    }
+
+    // second pass: the intermediate points of each queue, for as long as the pool allows
+
+    for ( int32 i = 0; i < numParamsChanged; ++i )
+    {
+        IParamValueQueue* paramQueue = paramChanges->getParameterData( i );
+        if ( !paramQueue )
+            continue;
+
+        int32 lastPoint = std::min( paramQueue->getPointCount() - 1, MAX_EVENTS - 1 );
+
+        for ( int32 p = 0; p < lastPoint && _numEvents < MAX_EVENTS; ++p )
+            addEvent( paramQueue, p, i * MAX_EVENTS + p );
+    }
+
+    // sort by offset, points sharing an offset are applied in the order the host provided them
+
+    std::sort( _events, _events + _numEvents, []( const Event& a, const Event& b ) {
+        return a.sampleOffset < b.sampleOffset || ( a.sampleOffset == b.sampleOffset && a.order < b.order );
+    });
+}
+
+bool AutomationScheduler::next( SubBlock& subBlock )
+{
+    if ( _position >= _numSamples ) {
+        // a zero length block is a parameter flush, still report its events once
+        if ( _flushed || _numSamples > 0 )
+            return false;
+
+        _flushed = true;
+
+        subBlock.offset    = 0;
+        subBlock.length    = 0;
+        subBlock.events    = _events;
+        subBlock.numEvents = _numEvents;
+
+        _eventIndex = _numEvents;
+
+        return true;
+    }
+
+    int32 start      = _position;
+    int32 firstEvent = _eventIndex;
+
+    // all events at (or, when they were postponed by the minimum sub block size, before)
+    // the current position are to be applied prior to processing the sub block
+
+    while ( _eventIndex < _numEvents && _events[ _eventIndex ].sampleOffset <= start )
+        ++_eventIndex;
+
+    // the sub block runs up until the next change point, but is never smaller than the minimum size
+
+    int32 end = ( _eventIndex < _numEvents ) ? _events[ _eventIndex ].sampleOffset : _numSamples;
+    end = std::min( _numSamples, std::max( end, start + MIN_SUB_BLOCK_SIZE ));
+
+    // a sub block stretched up to the end of the block while change points remain ends short at the
+    // last of these points instead, so they are applied late (at that point) as in all other sub blocks,
+    // rather than early (at the start of this sub block). This adds at most one short sub block per cycle
+
+    if ( end == _numSamples && _eventIndex < _numEvents )
+        end = _events[ _numEvents - 1 ].sampleOffset;
+
+    _position = end;
+
+    // the final sub block applies all remaining events
+
+    if ( _position >= _numSamples ) {
+        _eventIndex = _numEvents;
+        _flushed    = true;
+    }
+
+    subBlock.offset    = start;
+    subBlock.length    = end - start;
+    subBlock.events    = _events + firstEvent;
+    subBlock.numEvents = _eventIndex - firstEvent;
+
+    return true;
+}
+
+/* private methods */
+
+void AutomationScheduler::addEvent( IParamValueQueue* queue, int32 pointIndex, int32 order )
+{
+    Event& event = _events[ _numEvents ];
+
+    if ( queue->getPoint( pointIndex, event.sampleOffset, event.value ) != kResultTrue )
+        return;
+
+    event.sampleOffset = std::min( std::max( 0, event.sampleOffset ), std::max( 0, _numSamples - 1 ));
+    event.paramId      = queue->getParameterId();
+    event.order        = order;
+
+    ++_numEvents;
+}
+
+}
@@ -0,0 +1,95 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __AUTOMATIONSCHEDULER_H_INCLUDED__
+#define __AUTOMATIONSCHEDULER_H_INCLUDED__
+
+#include "global.h"
+#include "pluginterfaces/vst/ivstparameterchanges.h"
+
+using namespace Steinberg;
+using namespace Steinberg::Vst;
+
+/**
+ * AutomationScheduler merges the points of all parameter queues provided
+ * by the host for a single process cycle into a list sorted by sample offset.
+ * The audio block can then be processed in sub blocks in between the
+ * change points, so automation is applied (nearly) sample accurate.
+ *
+ * All events are stored in a fixed size pool, no allocation takes place
+ * while scheduling, making this safe to use on the audio thread.
+ */
+namespace Igorski {
+class AutomationScheduler {
+
+    public:
+        // the maximum amount of automation points that can be scheduled for a
+        // single process cycle. When a host supplies more points, only the last
+        // point of each parameter queue is guaranteed to be applied
+
+        static const int32 MAX_EVENTS = 512;
+
+        // the minimum size of a sub block (in samples). Change points that are
+        // closer together are applied at the next sub block boundary, which keeps
+        // the amount of sub blocks (and thus the CPU load) bounded for dense automation
+
+        static const int32 MIN_SUB_BLOCK_SIZE = 32;
+
+        struct Event {
+            int32 sampleOffset;
+            int32 order; // position of the point within the host queues, keeps sorting stable
+            ParamID paramId;
+            ParamValue value;
+        };
+
+        struct SubBlock {
+            int32 offset;       // offset of the sub block within the process cycles audio block
+            int32 length;       // length of the sub block (in samples), can be 0 when the host flushes parameters
+            const Event* events;
+            int32 numEvents;    // amount of events to apply before processing the sub block
+        };
+
+        AutomationScheduler();
+        ~AutomationScheduler();
+
+        // collect and sort the change points for a process cycle of given length
+        // (paramChanges can be null when the host has no changes to report)
+
+        void schedule( IParameterChanges* paramChanges, int32 numSamples );
+
+        // retrieve the next sub block to process, returns false when the full block has been processed
+
+        bool next( SubBlock& subBlock );
+
+    private:
+        Event _events[ MAX_EVENTS ];
+        int32 _numEvents;
+        int32 _eventIndex;
+        int32 _numSamples;
+        int32 _position;
+        bool _flushed;
+
+        void addEvent( IParamValueQueue* queue, int32 pointIndex, int32 order );
+};
+}
+
+#endif
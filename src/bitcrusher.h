@@ -23,9 +23,16 @@
 #ifndef __BITCRUSHER_H_INCLUDED__
 #define __BITCRUSHER_H_INCLUDED__
 
+#include "global.h"
+#include "calc.h"
+#include "kernels.h"
 #include "lfo.h"
+#include "smoothedvalue.h"
+#include <limits.h>
+#include <math.h>
 
 namespace Igorski {
+template <typename SampleType>
 class BitCrusher {
 
     public:
@@ -33,20 +40,35 @@ class BitCrusher {
         ~BitCrusher();
 
         void setLFO( float LFORatePercentage, float LFODepth );
-        void process( float* inBuffer, int bufferSize );
+        // apply effect onto given buffer of interleaved frames (bufferSize being the amount of frames)
+        void process( SampleType* inBuffer, int numChannels, int bufferSize );
+
+        // whether processing alters the signal (e.g. it is crushed below the full 16-bit resolution or modulated)
+        bool isActive();
+
+        // advance the modulation by given amount of (not oversampled) frames without processing
+        // the signal, to be used instead of process() while the effect is inactive
+        void skip( int amountOfFrames );
+
+        // the factor by which the frames supplied to process() are oversampled (1 when not oversampled)
+        // the modulation (LFO and mix) advances once per group of this many frames, so the effect
+        // behaves the same at any factor (bufferSize must be a multiple of the factor)
+
+        void setOversamplingFactor( int factor );
 
         void setAmount( float value ); // range between -1 to +1
         void setInputMix( float value );
         void setOutputMix( float value );
 
-        LFO* lfo;
+        LFO<SampleType>* lfo;
         bool hasLFO;
 
     private:
         int _bits; // we scale the amount to integers in the 1-16 range
+        int _oversamplingFactor;
         float _amount;
-        float _inputMix;
-        float _outputMix;
+        SmoothedValue* _inputMix;
+        SmoothedValue* _outputMix;
 
         void cacheLFO();
         void calcBits();
@@ -58,4 +80,6 @@ class BitCrusher {
 };
 }
 
+#include "bitcrusher.tcc"
+
 #endif
@@ -0,0 +1,199 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013-2018 Igor Zinken - http://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+/* constructor */
+
+template <typename SampleType>
+BitCrusher<SampleType>::BitCrusher( float amount, float inputMix, float outputMix )
+{
+    _inputMix  = new SmoothedValue( Calc::cap( inputMix ),  20.f, SmoothedValue::LINEAR );
+    _outputMix = new SmoothedValue( Calc::cap( outputMix ), 20.f, SmoothedValue::LINEAR );
+
+    setAmount   ( amount );
+    setInputMix ( inputMix );
+    setOutputMix( outputMix );
+
+    _tempAmount = _amount;
+
+    lfo = new LFO<SampleType>();
+    hasLFO = false;
+
+    _oversamplingFactor = 1;
+}
+
+template <typename SampleType>
+BitCrusher<SampleType>::~BitCrusher()
+{
+    delete lfo;
+    delete _inputMix;
+    delete _outputMix;
+}
+
+/* public methods */
+
+template <typename SampleType>
+void BitCrusher<SampleType>::setLFO( float LFORatePercentage, float LFODepth )
+{
+    bool wasEnabled = hasLFO;
+    bool enabled    = LFORatePercentage > 0.f;
+
+    hasLFO = enabled;
+
+    bool hadChange = ( wasEnabled != enabled ) || _lfoDepth != LFODepth;
+
+    if ( enabled )
+        lfo->setRate(
+            VST::MIN_LFO_RATE() + (
+                LFORatePercentage * ( VST::MAX_LFO_RATE() - VST::MIN_LFO_RATE() )
+            )
+        );
+
+    // turning LFO off
+    if ( !hasLFO && wasEnabled ) {
+        _tempAmount = _amount;
+        calcBits();
+    }
+
+    if ( hadChange ) {
+        _lfoDepth = LFODepth;
+        cacheLFO();
+    }
+}
+
+template <typename SampleType>
+void BitCrusher<SampleType>::process( SampleType* inBuffer, int numChannels, int bufferSize )
+{
+    int amountOfFrames = bufferSize / _oversamplingFactor;
+
+    // sound should not be crushed ? do nothing (other than keeping the mix ramps in time)
+    if ( !isActive() ) {
+        skip( amountOfFrames );
+        return;
+    }
+
+    const Kernels::Table<SampleType>& kernels = Kernels::get<SampleType>();
+
+    int groupChannels = numChannels * _oversamplingFactor; // samples in a group of oversampled frames
+    int i = 0;
+
+    // all channels of a frame (and its oversampled frames) are crushed at the same resolution
+    // frames are crushed in runs that share their resolution and mix. While a mix is gliding
+    // a run spans a single frame, otherwise it lasts until the LFO changes the resolution
+
+    while ( i < amountOfFrames )
+    {
+        int runStart   = i;
+        int bits       = _bits;
+        bool isGliding = _inputMix->isRamping() || _outputMix->isRamping();
+
+        SampleType inputMix  = _inputMix->next();
+        SampleType outputMix = _outputMix->next();
+
+        do {
+            if ( hasLFO ) {
+                // multiply by .5 and add .5 to make the LFO's bipolar waveform unipolar
+                float lfoValue = ( float ) lfo->peek() * .5f  + .5f;
+                _tempAmount = std::min( _lfoMax, _lfoMin + _lfoRange * lfoValue );
+
+                // recalculate the current resolution
+                calcBits();
+            }
+        } while ( ++i < amountOfFrames && !isGliding && _bits == bits );
+
+        int runLength = i - runStart;
+
+        // keep the (steady) mix ramps in time with the remaining frames of the run
+        _inputMix->skip( runLength - 1 );
+        _outputMix->skip( runLength - 1 );
+
+        kernels.crush( inBuffer + runStart * groupChannels, runLength * groupChannels, bits, inputMix, outputMix );
+    }
+}
+
+template <typename SampleType>
+bool BitCrusher<SampleType>::isActive()
+{
+    return _bits != 16 || hasLFO;
+}
+
+template <typename SampleType>
+void BitCrusher<SampleType>::skip( int amountOfFrames )
+{
+    _inputMix->skip( amountOfFrames );
+    _outputMix->skip( amountOfFrames );
+}
+
+template <typename SampleType>
+void BitCrusher<SampleType>::setOversamplingFactor( int factor )
+{
+    _oversamplingFactor = std::max( 1, factor );
+}
+
+/* setters */
+
+template <typename SampleType>
+void BitCrusher<SampleType>::setAmount( float value )
+{
+    float tempRatio = _tempAmount / std::max( 0.000000001f, _amount );
+
+    _amount = value;
+
+    // in case BitCrusher is attached to oscillator, keep relative offset
+    // of currently moving bit resolution in place
+    _tempAmount = ( hasLFO ) ? _amount * tempRatio : _amount;
+
+    cacheLFO();
+    calcBits();
+}
+
+template <typename SampleType>
+void BitCrusher<SampleType>::setInputMix( float value )
+{
+    _inputMix->setTarget( Calc::cap( value ));
+}
+
+template <typename SampleType>
+void BitCrusher<SampleType>::setOutputMix( float value )
+{
+    _outputMix->setTarget( Calc::cap( value ));
+}
+
+/* private methods */
+
+template <typename SampleType>
+void BitCrusher<SampleType>::cacheLFO()
+{
+    _lfoRange = ( float ) _amount * _lfoDepth;
+    _lfoMax   = std::min( 1.f, ( float ) _amount + _lfoRange / 2.f );
+    _lfoMin   = std::max( 0.f, ( float ) _amount - _lfoRange / 2.f );
+}
+
+template <typename SampleType>
+void BitCrusher<SampleType>::calcBits()
+{
+    // scale float to 1 - 16 bit range
+    _bits = ( int ) floor( Calc::scale( _tempAmount, 1, 15 )) + 1;
+}
+
+}
@@ -52,6 +52,15 @@ namespace Calc {
         return secondsToBuffer( milliseconds / 1000.f );
     }
 
+    /**
+     * convert given value in seconds to the exact (e.g. fractional)
+     * amount of samples it spans (for the current sampling rate)
+     */
+    inline double secondsToSamples( double seconds )
+    {
+        return seconds * Igorski::VST::SAMPLE_RATE;
+    }
+
     // convenience method to ensure given value is within the 0.f - +1.f range
 
     inline float cap( float value )
@@ -61,9 +70,10 @@ namespace Calc {
 
     // convenience method to ensure a sample is in the valid -1.f - +1.f range
 
-    inline float capSample( float value )
+    template <typename SampleType>
+    inline SampleType capSample( SampleType value )
     {
-        return std::min( 1.f, std::max( -1.f, value ));
+        return std::min(( SampleType ) 1, std::max(( SampleType ) -1, value ));
     }
 
     // convenience method to round given number value to the nearest
@@ -89,6 +99,31 @@ namespace Calc {
         return ( float ) ( std::min( maxValue, value ) * ratio );
     }
 
+    // flush given value to zero when it is approaching the denormal range
+    // to be applied onto feedback state (e.g. filter memory) as it decays
+
+    template <typename SampleType>
+    inline SampleType flushDenormal( SampleType value )
+    {
+        return ( fabs( value ) < ( SampleType ) VST::DENORMAL_THRESHOLD ) ? ( SampleType ) 0 : value;
+    }
+
+    // the amount of times a full scale signal can be fed back at given gain before it
+    // decays below the silence threshold, infinite when the gain does not attenuate
+
+    inline double feedbackRepeats( double gain )
+    {
+        gain = fabs( gain );
+
+        if ( gain < VST::SILENCE_THRESHOLD )
+            return 0.0;
+
+        if ( gain >= 1.0 )
+            return INFINITY;
+
+        return ceil( log( VST::SILENCE_THRESHOLD ) / log( gain ));
+    }
+
     // cast a floating point value to a boolean true/false
 
     inline bool toBool( float value )
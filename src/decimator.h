@@ -23,9 +23,12 @@
 #ifndef __DECIMATOR_H_INCLUDED__
 #define __DECIMATOR_H_INCLUDED__
 
-#include "audiobuffer.h"
+#include "calc.h"
+#include "smoothedvalue.h"
+#include <math.h>
 
 namespace Igorski {
+template <typename SampleType>
 class Decimator {
 
     public:
@@ -43,22 +46,31 @@ class Decimator {
         float getRate();
         void setRate( float value );
 
-        void process( float* sampleBuffer, int bufferSize );
+        // apply effect onto given buffer of interleaved frames (bufferSize being the amount of frames)
+        void process( SampleType* sampleBuffer, int numChannels, int bufferSize );
 
-        // store/restore the processor properties
-        // this ensures that multi channel processing for a
-        // single buffer uses all properties across all channels
+        // whether processing alters the signal (e.g. the resolution is below 32 bits)
+        bool isActive();
 
-        void store();
-        void restore();
+        // advance the internal oscillator by given amount of (not oversampled) frames without
+        // processing the signal, to be used instead of process() while the effect is inactive
+        void skip( int amountOfFrames );
+
+        // the factor by which the frames supplied to process() are oversampled (1 when not oversampled)
+        // the internal oscillator advances once per group of this many frames, so the effect
+        // behaves the same at any factor (bufferSize must be a multiple of the factor)
+
+        void setOversamplingFactor( int factor );
 
     private:
         int _bits;
+        int _oversamplingFactor;
         long _m;
-        float _rate;
-        float _accumulator;
-        float _accumulatorStored;
+        SmoothedValue* _rate;
+        SampleType _accumulator;
 };
 }
 
+#include "decimator.tcc"
+
 #endif
@@ -0,0 +1,132 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013-2018 Igor Zinken - http://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+/* constructor / destructor */
+
+template <typename SampleType>
+Decimator<SampleType>::Decimator( int bits, float rate )
+{
+    _rate = new SmoothedValue( Calc::cap( rate ), 20.f, SmoothedValue::LINEAR );
+
+    setBits( bits );
+    setRate( rate );
+
+    _accumulator        = 0.0;
+    _oversamplingFactor = 1;
+}
+
+template <typename SampleType>
+Decimator<SampleType>::~Decimator()
+{
+    delete _rate;
+}
+
+/* getters / setters */
+
+template <typename SampleType>
+int Decimator<SampleType>::getBits()
+{
+    return _bits;
+}
+
+template <typename SampleType>
+void Decimator<SampleType>::setBits( int value )
+{
+    // cap in 1 - 32 range
+    _bits = std::min( 32, std::max( 1, value ));
+    _m    = 1 << ( _bits - 1 );
+}
+
+template <typename SampleType>
+float Decimator<SampleType>::getRate()
+{
+    return _rate->getTarget();
+}
+
+template <typename SampleType>
+void Decimator<SampleType>::setRate( float value )
+{
+    _rate->setTarget( Calc::cap( value ));
+}
+
+/* public methods */
+
+template <typename SampleType>
+void Decimator<SampleType>::process( SampleType* sampleBuffer, int numChannels, int bufferSize )
+{
+    int amountOfFrames = bufferSize / _oversamplingFactor;
+
+    // full resolution ? do nothing (other than keeping the oscillator in time)
+    if ( !isActive() ) {
+        skip( amountOfFrames );
+        return;
+    }
+
+    SampleType m = ( SampleType ) _m;
+    int groupChannels = numChannels * _oversamplingFactor; // samples in a group of oversampled frames
+
+    for ( int i = 0; i < amountOfFrames; ++i )
+    {
+        _accumulator += _rate->next();
+
+        if ( _accumulator >= 1 )
+        {
+            _accumulator -= 1;
+
+            // the oscillator peaked, apply the effect onto all channels of the frame (and its oversampled frames)
+
+            SampleType* frame = sampleBuffer + i * groupChannels;
+
+            for ( int c = 0; c < groupChannels; ++c ) {
+                frame[ c ] = m * floor( frame[ c ] / m + ( SampleType ) .5 );
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+bool Decimator<SampleType>::isActive()
+{
+    return _bits < 32;
+}
+
+template <typename SampleType>
+void Decimator<SampleType>::skip( int amountOfFrames )
+{
+    for ( int i = 0; i < amountOfFrames; ++i )
+    {
+        _accumulator += _rate->next();
+
+        if ( _accumulator >= 1 )
+            _accumulator -= 1;
+    }
+}
+
+template <typename SampleType>
+void Decimator<SampleType>::setOversamplingFactor( int factor )
+{
+    _oversamplingFactor = std::max( 1, factor );
+}
+
+}
@@ -0,0 +1,161 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __DELAYLINE_H_INCLUDED__
+#define __DELAYLINE_H_INCLUDED__
+
+#include <algorithm>
+#include <string.h>
+
+/**
+ * DelayLine is a ring buffer of interleaved frames (e.g. L R L R for stereo)
+ * Its capacity is a power of two so positions wrap by masking rather than by
+ * comparison. Frames are read and written in blocks, where each block maps
+ * onto at most two contiguous regions ("spans") of the ring buffer memory: one
+ * up to the end of the buffer and one from its start, allowing blocks to be
+ * copied and processed as plain contiguous memory.
+ *
+ * A block of frames is written at the current write position, after which the
+ * write position is advanced. Frames are read relative to the write position,
+ * e.g. reading with a delay of 10 frames starts at the frame written 10 frames ago.
+ *
+ * Delays can be fractional, in which case the frames are interpolated from the
+ * surrounding frames using one of the Interpolation kernels. As the delay is constant
+ * for a block, the kernel weights are calculated once and the block is rendered as a
+ * weighted sum of shifted contiguous regions (which the compiler can vectorize).
+ */
+namespace Igorski {
+
+// the kernels available for interpolating frames when reading at a fractional delay
+// LINEAR interpolates between two frames, HERMITE (cubic Catmull-Rom spline) and
+// LAGRANGE (third order polynomial) interpolate using the four surrounding frames
+
+namespace Interpolation {
+    enum Type {
+        LINEAR = 0,
+        HERMITE,
+        LAGRANGE
+    };
+}
+
+template <typename SampleType>
+class DelayLine
+{
+    public:
+        DelayLine();
+        ~DelayLine();
+
+        // a contiguous region of the ring buffer, length is in frames
+
+        struct Span {
+            SampleType* frames;
+            int length;
+        };
+
+        // (re)create the ring buffer to hold given maximum delay (in frames, excluding its fractional
+        // part) for given amount of channels, the contents are cleared. This allocates when either value changes and should
+        // not be invoked while processing
+
+        void resize( int amountOfChannels, int maxDelay );
+        void clear();
+
+        int getAmountOfChannels();
+        int getCapacity();      // in frames, always a power of two
+        int getMaxDelay();      // in frames
+
+        // retrieve the span(s) of memory holding given length of frames, starting at given delay
+        // behind the write position (delay must be in the 1 - getMaxDelay() range and length may
+        // not exceed delay as to only contain frames that were written prior to this request)
+        // returns the amount of spans (1 or 2)
+
+        int getReadSpans( int delay, int length, Span* spans );
+
+        // retrieve the span(s) of memory to write given length of frames into at the write position
+        // (length may not exceed getCapacity()), returns the amount of spans (1 or 2)
+
+        int getWriteSpans( int length, Span* spans );
+
+        // advance the write position by given amount of frames, should be invoked after writing
+
+        void advance( int length );
+
+        // retrieve the frame at given delay behind the write position (where a delay of 0 returns
+        // the frame at the write position), for processing frame by frame (e.g. for delays too
+        // short to benefit from block processing)
+
+        inline SampleType* getFrame( int delay )
+        {
+            return _buffer + (( _writeIndex - delay ) & _mask ) * _amountOfChannels;
+        }
+
+        // convenience methods to copy given length of frames from/into given buffer of interleaved frames
+        // numChannels specifies the amount of channels in the buffer (cannot exceed getAmountOfChannels())
+        // note write() advances the write position
+
+        void read( int delay, SampleType* outputBuffer, int numChannels, int length );
+        void write( const SampleType* inputBuffer, int numChannels, int length );
+
+        // read given length of frames at given fractional delay into given buffer of interleaved frames,
+        // interpolated using given kernel. As the interpolation requires the frames surrounding the delay,
+        // length may not exceed getMaxReadLength() and delay may not be less than getMinimumDelay()
+
+        void read( double delay, Interpolation::Type interpolation, SampleType* outputBuffer, int numChannels, int length );
+
+        // read a single frame at given fractional delay, as the delay can differ for each
+        // invocation this can be used for modulated delays (see read() for the requirements)
+
+        void readFrame( double delay, Interpolation::Type interpolation, SampleType* outputFrame, int numChannels );
+
+        // the minimum delay (in frames) that can be read using given kernel
+
+        static int getMinimumDelay( Interpolation::Type interpolation );
+
+        // the maximum amount of frames that can be read in a single block at given delay using given
+        // kernel, as to only contain frames that were written prior to the read
+
+        static int getMaxReadLength( double delay, Interpolation::Type interpolation );
+
+    private:
+        SampleType* _buffer;
+        int _amountOfChannels;
+        int _capacity;
+        int _mask;
+        int _maxDelay;
+        int _writeIndex;
+
+        int getSpans( int index, int length, Span* spans );
+
+        // calculate the weights of the taps used to interpolate at given fraction x (0 - 1 range,
+        // 0 being the frame at the integer delay), ordered from the oldest frame onwards.
+        // returns the amount of taps and the delay of the oldest frame relative to the integer delay
+
+        static int getWeights( Interpolation::Type interpolation, SampleType x, SampleType* weights, int& oldestOffset );
+
+        // the frame at given index into the ring buffer interpolated from given amount of taps
+
+        void interpolateFrame( int index, const SampleType* weights, int numTaps, SampleType* outputFrame, int numChannels );
+};
+}
+
+#include "delayline.tcc"
+
+#endif
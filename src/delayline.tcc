@@ -0,0 +1,324 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+/* constructor / destructor */
+
+template <typename SampleType>
+DelayLine<SampleType>::DelayLine()
+{
+    _buffer           = 0;
+    _amountOfChannels = 0;
+    _capacity         = 0;
+    _mask             = 0;
+    _maxDelay         = 0;
+    _writeIndex       = 0;
+}
+
+template <typename SampleType>
+DelayLine<SampleType>::~DelayLine()
+{
+    delete[] _buffer;
+}
+
+/* public methods */
+
+template <typename SampleType>
+void DelayLine<SampleType>::resize( int amountOfChannels, int maxDelay )
+{
+    // the capacity holds the maximum delay, the frames surrounding it (for interpolating
+    // a fractional delay) and the frame currently being written
+
+    int capacity = 1;
+
+    while ( capacity < maxDelay + 3 )
+        capacity <<= 1;
+
+    _maxDelay = maxDelay;
+
+    if ( _buffer == 0 || capacity != _capacity || amountOfChannels != _amountOfChannels ) {
+        delete[] _buffer;
+
+        _amountOfChannels = amountOfChannels;
+        _capacity         = capacity;
+        _mask             = capacity - 1;
+        _buffer           = new SampleType[ capacity * amountOfChannels ];
+    }
+    clear();
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::clear()
+{
+    memset( _buffer, 0, _capacity * _amountOfChannels * sizeof( SampleType ));
+    _writeIndex = 0;
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getAmountOfChannels()
+{
+    return _amountOfChannels;
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getCapacity()
+{
+    return _capacity;
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getMaxDelay()
+{
+    return _maxDelay;
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getReadSpans( int delay, int length, Span* spans )
+{
+    return getSpans(( _writeIndex - delay ) & _mask, length, spans );
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getWriteSpans( int length, Span* spans )
+{
+    return getSpans( _writeIndex, length, spans );
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::advance( int length )
+{
+    _writeIndex = ( _writeIndex + length ) & _mask;
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::read( int delay, SampleType* outputBuffer, int numChannels, int length )
+{
+    Span spans[ 2 ];
+    int numSpans = getReadSpans( delay, length, spans );
+
+    for ( int s = 0; s < numSpans; ++s )
+    {
+        if ( numChannels == _amountOfChannels ) {
+            memcpy( outputBuffer, spans[ s ].frames, spans[ s ].length * numChannels * sizeof( SampleType ));
+        }
+        else {
+            for ( int i = 0; i < spans[ s ].length; ++i ) {
+                memcpy( outputBuffer + i * numChannels, spans[ s ].frames + i * _amountOfChannels, numChannels * sizeof( SampleType ));
+            }
+        }
+        outputBuffer += spans[ s ].length * numChannels;
+    }
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::write( const SampleType* inputBuffer, int numChannels, int length )
+{
+    Span spans[ 2 ];
+    int numSpans = getWriteSpans( length, spans );
+
+    for ( int s = 0; s < numSpans; ++s )
+    {
+        if ( numChannels == _amountOfChannels ) {
+            memcpy( spans[ s ].frames, inputBuffer, spans[ s ].length * numChannels * sizeof( SampleType ));
+        }
+        else {
+            for ( int i = 0; i < spans[ s ].length; ++i ) {
+                memcpy( spans[ s ].frames + i * _amountOfChannels, inputBuffer + i * numChannels, numChannels * sizeof( SampleType ));
+            }
+        }
+        inputBuffer += spans[ s ].length * numChannels;
+    }
+    advance( length );
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::read( double delay, Interpolation::Type interpolation, SampleType* outputBuffer, int numChannels, int length )
+{
+    int integerDelay    = ( int ) delay;
+    SampleType fraction = ( SampleType ) ( delay - integerDelay );
+
+    // an integer delay requires no interpolation and can be copied as is
+
+    if ( fraction == 0 ) {
+        read( integerDelay, outputBuffer, numChannels, length );
+        return;
+    }
+
+    SampleType weights[ 4 ];
+    int oldestOffset;
+    int numTaps = getWeights( interpolation, fraction, weights, oldestOffset );
+    int lastTap = numTaps - 1;
+    int index   = ( _writeIndex - ( integerDelay + oldestOffset )) & _mask;
+
+    for ( int i = 0; i < length; )
+    {
+        // the amount of frames for which all taps are within a contiguous region of memory
+
+        int contiguous = std::min( length - i, _capacity - index - lastTap );
+        SampleType* outputFrames = outputBuffer + i * numChannels;
+
+        if ( contiguous <= 0 ) {
+            // the taps of this frame wrap around the end of the buffer
+            interpolateFrame( index, weights, numTaps, outputFrames, numChannels );
+            contiguous = 1;
+        }
+        else if ( numChannels == _amountOfChannels ) {
+
+            // the output is the weighted sum of the frame regions starting at each tap, each
+            // region is offset by a single frame (e.g. the amount of channels in samples)
+
+            const SampleType* frames = _buffer + index * _amountOfChannels;
+            int stride = _amountOfChannels;
+            int numSamples = contiguous * numChannels;
+
+            if ( numTaps == 2 ) {
+                SampleType w0 = weights[ 0 ], w1 = weights[ 1 ];
+
+                for ( int j = 0; j < numSamples; ++j ) {
+                    outputFrames[ j ] = w0 * frames[ j ] + w1 * frames[ j + stride ];
+                }
+            }
+            else {
+                SampleType w0 = weights[ 0 ], w1 = weights[ 1 ], w2 = weights[ 2 ], w3 = weights[ 3 ];
+
+                for ( int j = 0; j < numSamples; ++j ) {
+                    outputFrames[ j ] = w0 * frames[ j ] + w1 * frames[ j + stride ] +
+                                        w2 * frames[ j + stride * 2 ] + w3 * frames[ j + stride * 3 ];
+                }
+            }
+        }
+        else {
+            for ( int f = 0; f < contiguous; ++f ) {
+                interpolateFrame( index + f, weights, numTaps, outputFrames + f * numChannels, numChannels );
+            }
+        }
+        i    += contiguous;
+        index = ( index + contiguous ) & _mask;
+    }
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::readFrame( double delay, Interpolation::Type interpolation, SampleType* outputFrame, int numChannels )
+{
+    int integerDelay    = ( int ) delay;
+    SampleType fraction = ( SampleType ) ( delay - integerDelay );
+
+    if ( fraction == 0 ) {
+        memcpy( outputFrame, getFrame( integerDelay ), numChannels * sizeof( SampleType ));
+        return;
+    }
+
+    SampleType weights[ 4 ];
+    int oldestOffset;
+    int numTaps = getWeights( interpolation, fraction, weights, oldestOffset );
+
+    interpolateFrame(( _writeIndex - ( integerDelay + oldestOffset )) & _mask, weights, numTaps, outputFrame, numChannels );
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getMinimumDelay( Interpolation::Type interpolation )
+{
+    // the four point kernels require the frame following the frame at the integer delay
+
+    return ( interpolation == Interpolation::LINEAR ) ? 1 : 2;
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getMaxReadLength( double delay, Interpolation::Type interpolation )
+{
+    int integerDelay = ( int ) delay;
+
+    if ( delay == integerDelay || interpolation == Interpolation::LINEAR )
+        return integerDelay;
+
+    return integerDelay - 1;
+}
+
+/* private methods */
+
+template <typename SampleType>
+int DelayLine<SampleType>::getSpans( int index, int length, Span* spans )
+{
+    int firstLength = std::min( length, _capacity - index );
+
+    spans[ 0 ].frames = _buffer + index * _amountOfChannels;
+    spans[ 0 ].length = firstLength;
+
+    if ( firstLength == length )
+        return 1;
+
+    // wrapped around the end of the buffer, the remainder starts at the beginning
+
+    spans[ 1 ].frames = _buffer;
+    spans[ 1 ].length = length - firstLength;
+
+    return 2;
+}
+
+template <typename SampleType>
+int DelayLine<SampleType>::getWeights( Interpolation::Type interpolation, SampleType x, SampleType* weights, int& oldestOffset )
+{
+    // x is the position between the frame at the integer delay (0) and the frame preceding it (1)
+    // the four point kernels additionally use the frames at positions -1 and 2
+
+    switch ( interpolation )
+    {
+        default:
+        case Interpolation::LINEAR:
+            oldestOffset = 1;
+            weights[ 0 ] = x;
+            weights[ 1 ] = 1 - x;
+            return 2;
+
+        case Interpolation::HERMITE:
+            oldestOffset = 2;
+            weights[ 0 ] = ( SampleType ) .5 * x * x * ( x - 1 );
+            weights[ 1 ] = x * (( SampleType ) .5 + x * ( 2 - ( SampleType ) 1.5 * x ));
+            weights[ 2 ] = 1 + x * x * (( SampleType ) 1.5 * x - ( SampleType ) 2.5 );
+            weights[ 3 ] = x * ( x * ( 1 - ( SampleType ) .5 * x ) - ( SampleType ) .5 );
+            return 4;
+
+        case Interpolation::LAGRANGE:
+            oldestOffset = 2;
+            weights[ 0 ] =  ( x + 1 ) * x * ( x - 1 ) / 6;
+            weights[ 1 ] = -( x + 1 ) * x * ( x - 2 ) / 2;
+            weights[ 2 ] =  ( x + 1 ) * ( x - 1 ) * ( x - 2 ) / 2;
+            weights[ 3 ] = -x * ( x - 1 ) * ( x - 2 ) / 6;
+            return 4;
+    }
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::interpolateFrame( int index, const SampleType* weights, int numTaps, SampleType* outputFrame, int numChannels )
+{
+    for ( int c = 0; c < numChannels; ++c ) {
+        SampleType sample = 0;
+
+        for ( int t = 0; t < numTaps; ++t ) {
+            sample += weights[ t ] * _buffer[ (( index + t ) & _mask ) * _amountOfChannels + c ];
+        }
+        outputFrame[ c ] = sample;
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "denormalguard.h"
+
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+#define DENORMALGUARD_SSE
+#include <xmmintrin.h>
+#elif defined( __aarch64__ ) && !defined( _MSC_VER )
+#define DENORMALGUARD_ARM64
+#endif
+
+namespace Igorski {
+
+#if defined( DENORMALGUARD_SSE )
+
+// the MXCSR flush-to-zero (bit 15) and denormals-are-zero (bit 6) flags
+static const unsigned int CSR_FTZ_DAZ = 0x8040;
+
+#elif defined( DENORMALGUARD_ARM64 )
+
+// the FPCR flush-to-zero flag (bit 24), which applies to both inputs and results
+static const unsigned long long FPCR_FZ = 1ULL << 24;
+
+#endif
+
+/* constructor / destructor */
+
+DenormalGuard::DenormalGuard()
+{
+#if defined( DENORMALGUARD_SSE )
+    _previousState = _mm_getcsr();
+    _mm_setcsr(( unsigned int ) _previousState | CSR_FTZ_DAZ );
+#elif defined( DENORMALGUARD_ARM64 )
+    asm volatile( "mrs %0, fpcr" : "=r"( _previousState ));
+    asm volatile( "msr fpcr, %0" : : "r"( _previousState | FPCR_FZ ));
+#else
+    _previousState = 0;
+#endif
+}
+
+DenormalGuard::~DenormalGuard()
+{
+#if defined( DENORMALGUARD_SSE )
+    _mm_setcsr(( unsigned int ) _previousState );
+#elif defined( DENORMALGUARD_ARM64 )
+    asm volatile( "msr fpcr, %0" : : "r"( _previousState ));
+#endif
+}
+
+}
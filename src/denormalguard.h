@@ -0,0 +1,53 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __DENORMALGUARD_H_INCLUDED__
+#define __DENORMALGUARD_H_INCLUDED__
+
+/**
+ * DenormalGuard enables the flush-to-zero (FTZ) and denormals-are-zero (DAZ)
+ * modes of the floating point unit for as long as it is in scope, restoring the
+ * previous modes when it goes out of scope. Create one on the stack at the start
+ * of a processing callback.
+ *
+ * Feedback paths (e.g. the delay, filter and flanger state) decay toward zero once
+ * their input stops, reaching the denormal range where arithmetic on x86 CPUs slows
+ * down by orders of magnitude. With these modes enabled, denormal values are treated
+ * as (and rounded to) zero. The modes are set on the thread's floating point unit
+ * as such they apply to all code executed in the scope, but only to the calling thread.
+ *
+ * Supported on x86 (SSE) and ARM64, on other platforms the guard does nothing.
+ */
+namespace Igorski {
+class DenormalGuard
+{
+    public:
+        DenormalGuard();
+        ~DenormalGuard();
+
+    private:
+        // the floating point control register state prior to construction
+        unsigned long long _previousState;
+};
+}
+
+#endif
@@ -24,16 +24,25 @@
 #define __FILTER_H_INCLUDED__
 
 #include "global.h"
+#include "calc.h"
+#include "kernels.h"
 #include "lfo.h"
+#include <algorithm>
 #include <math.h>
 
 namespace Igorski {
+template <typename SampleType>
 class Filter {
 
     public:
-        Filter();
+        Filter( int amountOfChannels );
         ~Filter();
 
+        // (re)create the filter state for given amount of channels
+        // this allocates and should not be called while processing
+
+        void setAmountOfChannels( int amountOfChannels );
+
         void  setCutoff( float frequency );
         float getCutoff();
         void  setResonance( float resonance );
@@ -42,22 +51,22 @@ class Filter {
         float getDepth();
         void setLFO( bool enabled );
 
+        // the amount of frames between updates of the coefficients while the LFO modulates
+        // the cutoff (1 updates them for every frame, higher values trade precision for speed)
+
+        void setControlInterval( int frames );
+        int getControlInterval();
+
         void calculateParameters();
 
         // update Filter properties, the values here are in normalized 0 - 1 range
         void updateProperties( float cutoffPercentage, float resonancePercentage, float LFORatePercentage, float fLFODepth );
 
         // apply filter to incoming sampleBuffer contents
-        void process( float* sampleBuffer, int bufferSize, int c );
+        // (interleaved frames, bufferSize being the amount of frames)
+        void process( SampleType* sampleBuffer, int numChannels, int bufferSize );
 
-        LFO* lfo;
-
-        // store/restore the processor properties
-        // this ensures that multi channel processing for a
-        // single buffer uses all properties across all channels
-
-        void store();
-        void restore();
+        LFO<SampleType>* lfo;
 
     private:
         float _cutoff;
@@ -68,26 +77,31 @@ class Filter {
         float _lfoMax;
         float _lfoRange;
         bool  _hasLFO;
+        int   _controlInterval;
+        int   _controlFrames; // frames elapsed since the last coefficient update
 
         // used internally
 
-        float _accumulatorStored;
-        float _tempCutoffStored;
+        SampleType _a1;
+        SampleType _a2;
+        SampleType _a3;
+        SampleType _b1;
+        SampleType _b2;
+        SampleType _c;
 
-        float _a1;
-        float _a2;
-        float _a3;
-        float _b1;
-        float _b2;
-        float _c;
+        // the filter state for each channel, laid out as
+        // separate arrays so the channels are stored contiguously
 
-        float* _in1;
-        float* _in2;
-        float* _out1;
-        float* _out2;
+        SampleType* _in1;
+        SampleType* _in2;
+        SampleType* _out1;
+        SampleType* _out2;
+        int _amountOfChannels;
 
         void cacheLFOProperties();
 };
 }
 
+#include "filter.tcc"
+
 #endif
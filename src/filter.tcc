@@ -0,0 +1,264 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2013-2018 Igor Zinken - http://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+template <typename SampleType>
+Filter<SampleType>::Filter( int amountOfChannels ) {
+
+    _cutoff     = VST::FILTER_MIN_FREQ;
+    _resonance  = VST::FILTER_MIN_RESONANCE;
+    _depth      = 1.f;
+    _lfoMin     = VST::FILTER_MIN_FREQ;
+    _lfoMax     = VST::FILTER_MAX_FREQ;
+    _lfoRange   = _cutoff * _depth;
+    _tempCutoff = _cutoff; // used when applying LFO
+
+    _a1 = 0.f;
+    _a2 = 0.f;
+    _a3 = 0.f;
+    _b1 = 0.f;
+    _b2 = 0.f;
+    _c  = 0.f;
+
+    lfo = new Igorski::LFO<SampleType>();
+
+    _hasLFO          = false;
+    _controlInterval = 1;
+    _controlFrames   = 0;
+
+    _in1  = 0;
+    _in2  = 0;
+    _out1 = 0;
+    _out2 = 0;
+    _amountOfChannels = 0;
+
+    setAmountOfChannels( amountOfChannels );
+    setCutoff( VST::FILTER_MAX_FREQ / 2 );
+}
+
+template <typename SampleType>
+Filter<SampleType>::~Filter() {
+    delete lfo;
+    delete[] _in1;
+    delete[] _in2;
+    delete[] _out1;
+    delete[] _out2;
+}
+
+/* public methods */
+
+template <typename SampleType>
+void Filter<SampleType>::setAmountOfChannels( int amountOfChannels )
+{
+    if ( _in1 != 0 && _amountOfChannels == amountOfChannels )
+        return;
+
+    delete[] _in1;
+    delete[] _in2;
+    delete[] _out1;
+    delete[] _out2;
+
+    _amountOfChannels = amountOfChannels;
+
+    _in1  = new SampleType[ amountOfChannels ];
+    _in2  = new SampleType[ amountOfChannels ];
+    _out1 = new SampleType[ amountOfChannels ];
+    _out2 = new SampleType[ amountOfChannels ];
+
+    for ( int i = 0; i < amountOfChannels; ++i )
+    {
+        _in1 [ i ] = 0;
+        _in2 [ i ] = 0;
+        _out1[ i ] = 0;
+        _out2[ i ] = 0;
+    }
+}
+
+template <typename SampleType>
+void Filter<SampleType>::updateProperties( float cutoffPercentage, float resonancePercentage, float LFORatePercentage, float LFODepth )
+{
+    float co  = VST::FILTER_MIN_FREQ + ( cutoffPercentage * ( VST::FILTER_MAX_FREQ - VST::FILTER_MIN_FREQ ));
+    float res = VST::FILTER_MIN_RESONANCE + ( resonancePercentage * ( VST::FILTER_MAX_RESONANCE - VST::FILTER_MIN_RESONANCE ));
+
+    if ( _cutoff != co || _resonance != res ) {
+        setCutoff( co );
+        setResonance( res );
+    }
+    _depth = LFODepth;
+
+    bool doLFO = LFORatePercentage != 0.f;
+
+    if ( !doLFO && _hasLFO ) {
+        setLFO( false );
+    }
+    else if ( doLFO ) {
+        setLFO( true );
+        cacheLFOProperties();
+        lfo->setRate(
+            VST::MIN_LFO_RATE() + (
+                LFORatePercentage * ( VST::MAX_LFO_RATE() - VST::MIN_LFO_RATE() )
+            )
+        );
+    }
+}
+
+template <typename SampleType>
+void Filter<SampleType>::process( SampleType* sampleBuffer, int numChannels, int bufferSize )
+{
+    const Kernels::Table<SampleType>& kernels = Kernels::get<SampleType>();
+
+    SampleType* in1  = _in1;
+    SampleType* in2  = _in2;
+    SampleType* out1 = _out1;
+    SampleType* out2 = _out2;
+
+    // the frames are filtered in runs that share their coefficients (e.g. the entire buffer
+    // when no LFO is attached, otherwise the frames up until the next control interval)
+
+    for ( int i = 0; i < bufferSize; )
+    {
+        int runLength = _hasLFO ? std::min( bufferSize - i, std::max( 1, _controlInterval - _controlFrames )) : bufferSize - i;
+
+        kernels.biquad( sampleBuffer + i * numChannels, numChannels, runLength,
+                        _a1, _a2, _a3, _b1, _b2, in1, in2, out1, out2 );
+
+        i += runLength;
+
+        // oscillator attached to Filter ? travel the cutoff values
+        // between the minimum and maximum frequencies
+
+        if ( _hasLFO )
+        {
+            float lfoValue = 0.f;
+
+            // multiply by .5 and add .5 to make bipolar waveform unipolar
+            for ( int j = 0; j < runLength; ++j ) {
+                lfoValue = ( float ) lfo->peek() * .5f  + .5f;
+            }
+
+            if (( _controlFrames += runLength ) >= _controlInterval ) {
+                _controlFrames = 0;
+                _tempCutoff    = std::min( _lfoMax, _lfoMin + _lfoRange * lfoValue );
+
+                calculateParameters();
+            }
+        }
+    }
+
+    // flush the decaying filter state before it reaches the denormal range
+
+    for ( int c = 0; c < numChannels; ++c )
+    {
+        in1 [ c ] = Calc::flushDenormal( in1 [ c ]);
+        in2 [ c ] = Calc::flushDenormal( in2 [ c ]);
+        out1[ c ] = Calc::flushDenormal( out1[ c ]);
+        out2[ c ] = Calc::flushDenormal( out2[ c ]);
+    }
+}
+
+template <typename SampleType>
+void Filter<SampleType>::setCutoff( float frequency )
+{
+    // in case LFO is moving, set the current temp cutoff (last LFO value)
+    // to the relative value for the new cutoff frequency)
+
+    float tempRatio = _tempCutoff / _cutoff;
+
+    _cutoff     = std::max( VST::FILTER_MIN_FREQ, std::min( frequency, VST::FILTER_MAX_FREQ ));
+    _tempCutoff = _cutoff * tempRatio;
+
+    calculateParameters();
+}
+
+template <typename SampleType>
+float Filter<SampleType>::getCutoff()
+{
+    return _cutoff;
+}
+
+template <typename SampleType>
+void Filter<SampleType>::setResonance( float resonance )
+{
+    _resonance = std::max( VST::FILTER_MIN_RESONANCE, std::min( resonance, VST::FILTER_MAX_RESONANCE ));
+    calculateParameters();
+}
+
+template <typename SampleType>
+float Filter<SampleType>::getResonance()
+{
+    return _resonance;
+}
+
+template <typename SampleType>
+void Filter<SampleType>::setLFO( bool enabled )
+{
+    _hasLFO = enabled;
+
+    // no LFO ? make sure the filter returns to its default parameters
+
+    if ( !enabled )
+    {
+        _tempCutoff = _cutoff;
+        cacheLFOProperties();
+        calculateParameters();
+    }
+}
+
+template <typename SampleType>
+void Filter<SampleType>::setControlInterval( int frames )
+{
+    _controlInterval = std::max( 1, frames );
+}
+
+template <typename SampleType>
+int Filter<SampleType>::getControlInterval()
+{
+    return _controlInterval;
+}
+
+template <typename SampleType>
+void Filter<SampleType>::calculateParameters()
+{
+    // the coefficients are calculated at the processing precision
+
+    SampleType one       = 1;
+    SampleType two       = 2;
+    SampleType resonance = _resonance;
+
+    _c  = one / tan(( SampleType ) VST::PI * ( SampleType ) _tempCutoff / ( SampleType ) VST::SAMPLE_RATE );
+    _a1 = one / ( one + resonance * _c + _c * _c );
+    _a2 = two * _a1;
+    _a3 = _a1;
+    _b1 = two * ( one - _c * _c ) * _a1;
+    _b2 = ( one - resonance * _c + _c * _c ) * _a1;
+}
+
+template <typename SampleType>
+void Filter<SampleType>::cacheLFOProperties()
+{
+    _lfoRange = _cutoff * _depth;
+    _lfoMax   = std::min( VST::FILTER_MAX_FREQ, _cutoff + _lfoRange / 2.f );
+    _lfoMin   = std::max( VST::FILTER_MIN_FREQ, _cutoff - _lfoRange / 2.f );
+}
+
+}
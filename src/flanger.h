@@ -24,7 +24,11 @@
 #ifndef __FLANGER_H_INCLUDED__
 #define __FLANGER_H_INCLUDED__
 
-#include "lowpassfilter.h"
+#include "global.h"
+#include "calc.h"
+#include "smoothedvalue.h"
+#include <string.h>
+#include <math.h>
 #include <vector>
 
 // Adaptation of modf() by Dennis Cronin
@@ -37,15 +41,26 @@
 #define MODF(n,i,f) ((i) = (int)(n), (f) = (n) - (double)(i))
 
 /**
- * a mono/stereo Flanger effect (more channels currently not supported)
+ * a multichannel Flanger effect, all channels share the same sweep
  */
 namespace Igorski {
+template <typename SampleType>
 class Flanger
 {
     public:
         Flanger( int amountOfChannels );
         ~Flanger();
 
+        // (re)create the delay memory for given amount of channels
+        // this allocates and should not be called while processing
+
+        void setAmountOfChannels( int amountOfChannels );
+
+        // recalculate all sample rate dependent properties (e.g. delay memory) for the
+        // current VST::SAMPLE_RATE, this allocates when the required memory size changes
+
+        void updateSampleRate();
+
         float getRate();
         void setRate( float value );
         float getWidth();
@@ -57,14 +72,17 @@ class Flanger
         float getMix();
         void setMix( float value );
 
-        void process( float* sampleBuffer, int bufferSize, int c );
+        // apply effect onto given buffer of interleaved frames (bufferSize being the amount of frames)
+        void process( SampleType* sampleBuffer, int numChannels, int bufferSize );
 
-        // store/restore the processor properties
-        // this ensures that multi channel processing for a
-        // single buffer uses all properties across all channels
+        // whether the delay memory contains no audible signal (e.g. its feedback has decayed)
 
-        void store();
-        void restore();
+        bool isSilent();
+
+        // the amount of samples the effect continues to output after its input falls silent
+        // (can be infinite when the feedback does not attenuate)
+
+        double getTailSamples();
 
     protected:
 
@@ -77,17 +95,19 @@ class Flanger
         float _sweepSamples;
         float _maxSweepSamples;
         int _writePointer;
+        int _silentFrames; // amount of inaudible frames written since the last audible one
         float _step;
         float _sweep;
+        int _amountOfChannels;
 
-        int _writePointerStored;
-        float _sweepStored;
+        // the delay memory holds interleaved frames so the channels
+        // of a single frame are read and written from a contiguous region
 
-        std::vector<float*> _buffers;
-        std::vector<float>  _lastChannelSamples;
+        SampleType* _buffer;
+        std::vector<SampleType> _lastChannelSamples;
 
-        LowPassFilter* _delayFilter;
-        LowPassFilter* _mixFilter;
+        SmoothedValue* _delaySmoothing;
+        SmoothedValue* _mixSmoothing;
 
         float _mixLeftWet;
         float _mixLeftDry;
@@ -99,7 +119,10 @@ class Flanger
         float SAMPLE_MULTIPLIER;
 
         void calculateSweep();
+        void createBuffer();
 };
 }
 
+#include "flanger.tcc"
+
 #endif
@@ -0,0 +1,306 @@
+/**
+ * The MIT License (MIT)
+ *
+ * based on public source code by Dennis Cronin, adapted
+ * by Igor Zinken - http://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+/* constructor / destructor */
+
+template <typename SampleType>
+Flanger<SampleType>::Flanger( int amountOfChannels ) {
+
+    FLANGER_BUFFER_SIZE = ( int ) (( float ) VST::SAMPLE_RATE / 5.0f );
+    SAMPLE_MULTIPLIER   = ( float ) VST::SAMPLE_RATE * 0.01f;
+
+    _writePointer         = 0;
+    _feedbackPhase        = 1.f;
+    _sweepSamples         = 0.f;
+    _mixLeftWet           =
+    _mixRightWet          =
+    _mixLeftDry           =
+    _mixRightDry          = 1.f;
+
+    _amountOfChannels     = amountOfChannels;
+    _buffer               = 0;
+
+    createBuffer();
+
+    // delay and mix glide in from zero when starting out
+
+    _delaySmoothing = new SmoothedValue( 0.f, 50.f, SmoothedValue::EXPONENTIAL );
+    _mixSmoothing   = new SmoothedValue( 0.f, 50.f, SmoothedValue::EXPONENTIAL );
+
+    setRate( 0.1f );
+    setWidth( 0.5f );
+    setFeedback( 0.75f );
+    setDelay( .1f  );
+    setMix( 1.f );
+}
+
+template <typename SampleType>
+Flanger<SampleType>::~Flanger()
+{
+    delete _delaySmoothing;
+    delete _mixSmoothing;
+    delete[] _buffer;
+}
+
+/* public methods */
+
+template <typename SampleType>
+void Flanger<SampleType>::setAmountOfChannels( int amountOfChannels )
+{
+    if ( _amountOfChannels == amountOfChannels )
+        return;
+
+    _amountOfChannels = amountOfChannels;
+
+    createBuffer();
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::updateSampleRate()
+{
+    int bufferSize = ( int ) (( float ) VST::SAMPLE_RATE / 5.0f );
+
+    SAMPLE_MULTIPLIER = ( float ) VST::SAMPLE_RATE * 0.01f;
+
+    // the delay memory is only recreated when the required size changes
+
+    if ( bufferSize != FLANGER_BUFFER_SIZE ) {
+        FLANGER_BUFFER_SIZE = bufferSize;
+        createBuffer();
+    }
+
+    // recalculate the sweep range for the new rate
+    setWidth( _width );
+}
+
+template <typename SampleType>
+float Flanger<SampleType>::getRate()
+{
+    return _rate;
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::setRate( float value )
+{
+    _rate = value;
+
+    // map into param onto 0.05Hz - 10hz with log curve
+    _sweepRate  = pow( 10.0, ( float ) _rate );
+    _sweepRate -= 1.f;
+    _sweepRate *= 1.05556f;
+    _sweepRate += 0.05f;
+
+    calculateSweep();
+}
+
+template <typename SampleType>
+float Flanger<SampleType>::getWidth()
+{
+    return _width;
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::setWidth( float value )
+{
+    _width = value;
+
+    if ( value <= 0.05f )
+        _sweepSamples = 0.f;
+    else
+        _sweepSamples = value * SAMPLE_MULTIPLIER;
+
+    calculateSweep();
+}
+
+template <typename SampleType>
+float Flanger<SampleType>::getDelay()
+{
+    return _delay;
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::setDelay( float value )
+{
+    _delay = value;
+    _delaySmoothing->setTarget( value );
+}
+
+template <typename SampleType>
+float Flanger<SampleType>::getFeedback()
+{
+    return _feedback;
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::setFeedback( float value )
+{
+    _feedback = value;
+}
+
+template <typename SampleType>
+float Flanger<SampleType>::getMix()
+{
+    return _mix;
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::setMix( float value )
+{
+    _mix = value;
+    _mixSmoothing->setTarget( value );
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::process( SampleType* sampleBuffer, int numChannels, int bufferSize )
+{
+    int maxWriteIndex = FLANGER_BUFFER_SIZE - 1;
+    int stride        = _amountOfChannels;
+
+    SampleType* lastChannelSamples = _lastChannelSamples.data();
+
+    float delay, mix, delaySamples, ep;
+    SampleType sample, w1, w2, peak;
+    int ep1, ep2;
+
+    for ( int i = 0; i < bufferSize; i++ )
+    {
+        // smoothed delay and mix values
+
+        delay = _delaySmoothing->next();
+        mix   = _mixSmoothing->next();
+
+        if ( ++_writePointer > maxWriteIndex )
+            _writePointer = 0;
+
+        // delay 0.0-1.0 maps to 0.02ms to 10ms (always have at least 1 sample of delay)
+        delaySamples = ( delay * SAMPLE_MULTIPLIER ) + 1.f;
+        delaySamples += _sweep;
+
+        // build the two emptying pointers and do linear interpolation
+        ep = ( float ) _writePointer - delaySamples;
+
+        if ( ep < 0.0 )
+            ep += ( float ) FLANGER_BUFFER_SIZE;
+
+        MODF( ep, ep1, w2 );
+        w1 = 1.0 - w2;
+
+        if ( ++ep1 > maxWriteIndex )
+            ep1 = 0;
+
+        ep2 = ep1 + 1;
+
+        if ( ep2 > maxWriteIndex )
+            ep2 = 0;
+
+        // process input channels and write output back into the buffer
+        // the read and write positions are shared by all channels of the frame
+
+        SampleType* frame      = sampleBuffer + i * numChannels;
+        SampleType* writeFrame = _buffer + _writePointer * stride;
+        SampleType* readFrame1 = _buffer + ep1 * stride;
+        SampleType* readFrame2 = _buffer + ep2 * stride;
+
+        peak = 0;
+
+        for ( int c = 0; c < numChannels; ++c ) {
+            sample = frame[ c ];
+            // the fed back signal circulates through the delay memory, flush it before it
+            // decays into the denormal range (as it would otherwise remain there until overwritten)
+            writeFrame[ c ] = Calc::flushDenormal( sample + _feedback * _feedbackPhase * lastChannelSamples[ c ]);
+            lastChannelSamples[ c ] = readFrame1[ c ] * w1 + readFrame2[ c ] * w2;
+            frame[ c ] = Calc::capSample( _mixLeftDry * sample + _mixLeftWet * mix * lastChannelSamples[ c ]);
+            peak = std::max( peak, ( SampleType ) fabs( writeFrame[ c ]));
+        }
+
+        // keep track of the audibility of the delay memory contents
+
+        if ( peak < VST::SILENCE_THRESHOLD )
+            _silentFrames = std::min( _silentFrames + 1, FLANGER_BUFFER_SIZE );
+        else
+            _silentFrames = 0;
+
+        // process sweep
+
+        if ( _step != 0.0 )
+        {
+            _sweep += _step;
+
+            if ( _sweep <= 0.0 )
+            {
+                _sweep = 0.0;
+                _step = -_step;
+            }
+            else if ( _sweep >= _maxSweepSamples)
+                _step = -_step;
+        }
+    }
+}
+
+template <typename SampleType>
+bool Flanger<SampleType>::isSilent()
+{
+    // the delay is read within the memory range, once all of
+    // its frames are inaudible the output of the delay is too
+
+    return _silentFrames >= FLANGER_BUFFER_SIZE;
+}
+
+template <typename SampleType>
+double Flanger<SampleType>::getTailSamples()
+{
+    // the longest delay (see process()) is repeated for each time the signal is fed back
+
+    double maxDelaySamples = SAMPLE_MULTIPLIER * std::max( _delay, _delaySmoothing->getValue() ) + 1.0 + _maxSweepSamples;
+
+    return ( Calc::feedbackRepeats( _feedback * _feedbackPhase ) + 1.0 ) * maxDelaySamples;
+}
+
+/* protected methods */
+
+template <typename SampleType>
+void Flanger<SampleType>::createBuffer()
+{
+    delete[] _buffer;
+
+    // create delay buffer to write the flanger delay into
+
+    _buffer = new SampleType[ FLANGER_BUFFER_SIZE * _amountOfChannels ];
+    memset( _buffer, 0, FLANGER_BUFFER_SIZE * _amountOfChannels * sizeof( SampleType ));
+
+    _lastChannelSamples.assign( _amountOfChannels, 0.f );
+    _writePointer = 0;
+    _silentFrames = FLANGER_BUFFER_SIZE;
+}
+
+template <typename SampleType>
+void Flanger<SampleType>::calculateSweep()
+{
+    // translate sweep rate to samples per second
+    _step = ( float ) ( _sweepSamples * 2.f * _sweepRate ) / ( float ) VST::SAMPLE_RATE;
+    _maxSweepSamples = _sweepSamples;
+    _sweep = 0.f;
+}
+}
@@ -1,10 +1,11 @@
 #ifndef __GLOBAL_HEADER__
 #define __GLOBAL_HEADER__
 
-#include "pluginterfaces/base/fplatform.h"
-#include "pluginterfaces/base/funknown.h"
+#include <stdint.h>
 
-using namespace Steinberg;
+// note this header (as all headers of the DSP classes) does not depend on the Steinberg SDK
+// so the DSP can be compiled on its own (see the regrader_dsp library in CMakeLists.txt)
+// the identifiers of the plugin classes are defined in uids.h
 
 namespace Igorski {
 namespace VST {
@@ -13,12 +14,18 @@ namespace VST {
     static const char* NAME     = "Regrader";
     static const char* VENDOR   = "igorski.nl";
 
-    static const FUID RegraderProcessorUID( 0x9A615AD3, 0xFFF74B54, 0xA6AFDDE5, 0xD9995465 );
-    static const FUID RegraderWithSideChainProcessorUID( 0x31C358F3, 0x528F457D, 0xBA31BDFB, 0x70A7A2DA );
-    static const FUID RegraderControllerUID( 0xF99D622B, 0xCF48474A, 0xB7E202CD, 0x66D160D9 );
-
     extern float SAMPLE_RATE; // set upon initialization, see vst.cpp
 
+    // the level (linear amplitude, ~ -100 dB) below which a signal is considered silent
+    // used to determine when the tails of the effects have decayed
+
+    static const float SILENCE_THRESHOLD = 0.00001f;
+
+    // the level below which decaying feedback state is flushed to zero, well above the range
+    // of denormal numbers (for which arithmetic is very slow on x86 CPUs), also see DenormalGuard
+
+    static const double DENORMAL_THRESHOLD = 1e-15;
+
     static const float PI     = 3.141592653589793f;
     static const float TWO_PI = PI * 2.f;
 
@@ -0,0 +1,113 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __HALFBANDFILTER_H_INCLUDED__
+#define __HALFBANDFILTER_H_INCLUDED__
+
+#include "global.h"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+/**
+ * HalfBandFilter is a linear phase FIR lowpass filter with its cutoff at half the Nyquist
+ * frequency, used to double (upsample) or halve (downsample) the sample rate of a signal
+ * of interleaved frames (e.g. L R L R for stereo).
+ *
+ * Every other coefficient of a half-band filter is zero, apart from the center coefficient
+ * (which is .5). Both directions are implemented in polyphase form: when upsampling, the even
+ * output frames are the input convolved with the nonzero coefficients while the odd output
+ * frames are (delayed) copies of the input. When downsampling, the even input frames are convolved
+ * with the nonzero coefficients and the odd input frames are added at the center coefficient.
+ * As such, only the nonzero coefficients are evaluated, at the lower of both rates.
+ *
+ * The coefficients are symmetric, pairs of frames sharing a coefficient are summed prior to
+ * multiplication. The convolution is performed per coefficient over the full block of samples
+ * (regardless of channel) as contiguous multiply-add loops, which the compiler vectorizes.
+ *
+ * The coefficients are calculated once upon construction, the work buffers are sized for the
+ * maximum block length (see resize()), after which blocks of any length up to that maximum can
+ * be processed without allocating.
+ */
+namespace Igorski {
+template <typename SampleType>
+class HalfBandFilter
+{
+    public:
+
+        // numCoefficients is the amount of nonzero coefficients on either side of the center
+        // coefficient (the filter has numCoefficients * 4 - 1 taps), attenuation is the desired
+        // stopband attenuation in dB. Longer filters have a narrower transition band
+
+        HalfBandFilter( int numCoefficients, double attenuation );
+        ~HalfBandFilter();
+
+        // (re)create the work buffers for given amount of channels and maximum block length (in frames
+        // at the lower rate). This allocates when either value changes and should not be invoked while processing
+
+        void resize( int amountOfChannels, int maxLength );
+
+        // clear the filter history
+
+        void clear();
+
+        // upsample given length of frames into twice the length of frames in given output buffer
+        // (the buffers cannot overlap)
+
+        void upsample( const SampleType* inputBuffer, SampleType* outputBuffer, int numChannels, int length );
+
+        // downsample twice the given length of frames into length frames in given output buffer
+
+        void downsample( const SampleType* inputBuffer, SampleType* outputBuffer, int numChannels, int length );
+
+        // the group delay (in frames at the lower rate) introduced by either upsampling or downsampling
+
+        double getLatency();
+
+    private:
+        int _numCoefficients;
+        int _historyLength;   // in frames, the amount of frames preceding a block required for its convolution
+        int _amountOfChannels;
+        int _maxLength;
+
+        SampleType* _coefficients; // the nonzero coefficients on one side of the center, ordered from the center outwards
+        SampleType* _even;         // filter history followed by the current blocks (even) frames
+        SampleType* _odd;          // filter history followed by the current blocks odd frames (downsampling only)
+        SampleType* _accumulator;  // convolution output for the current block
+
+        // convolve given amount of samples (history excluded) of the work buffer with the nonzero coefficients
+
+        void convolve( const SampleType* workBuffer, int numChannels, int numSamples );
+
+        // move the last frames of given work buffer (holding length frames after its history) into its history
+
+        void updateHistory( SampleType* workBuffer, int numChannels, int length );
+
+        // zeroth order modified Bessel function of the first kind (used to calculate the Kaiser window)
+
+        static double besselI0( double x );
+};
+}
+
+#include "halfbandfilter.tcc"
+
+#endif
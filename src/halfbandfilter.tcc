@@ -0,0 +1,234 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+/* constructor / destructor */
+
+template <typename SampleType>
+HalfBandFilter<SampleType>::HalfBandFilter( int numCoefficients, double attenuation )
+{
+    _numCoefficients  = std::max( 1, numCoefficients );
+    _historyLength    = _numCoefficients * 2 - 1;
+    _amountOfChannels = 0;
+    _maxLength        = 0;
+    _even             = 0;
+    _odd              = 0;
+    _accumulator      = 0;
+
+    // the ideal half-band impulse response (sin( PI * n / 2 ) / ( PI * n )) is zero for all even n other
+    // than the center, the nonzero (odd) taps are shaped using a Kaiser window for given stopband attenuation
+
+    double beta = 0.0;
+
+    if ( attenuation > 50.0 )
+        beta = 0.1102 * ( attenuation - 8.7 );
+    else if ( attenuation > 21.0 )
+        beta = 0.5842 * pow( attenuation - 21.0, 0.4 ) + 0.07886 * ( attenuation - 21.0 );
+
+    double halfLength = _numCoefficients * 2.0;
+    double* taps      = new double[ _numCoefficients ];
+    double sum        = 0.0;
+
+    for ( int k = 0; k < _numCoefficients; ++k ) {
+        double n      = k * 2.0 + 1.0;
+        double ratio  = n / halfLength;
+        double window = besselI0( beta * sqrt( 1.0 - ratio * ratio )) / besselI0( beta );
+
+        taps[ k ] = (( k % 2 == 0 ) ? 1.0 : -1.0 ) / ( VST::PI * n ) * window;
+        sum += taps[ k ];
+    }
+
+    // normalize for unity gain at DC: the taps on both sides of the center sum up to .5
+
+    _coefficients = new SampleType[ _numCoefficients ];
+
+    for ( int k = 0; k < _numCoefficients; ++k ) {
+        _coefficients[ k ] = ( SampleType ) ( taps[ k ] * .25 / sum );
+    }
+    delete[] taps;
+}
+
+template <typename SampleType>
+HalfBandFilter<SampleType>::~HalfBandFilter()
+{
+    delete[] _coefficients;
+    delete[] _even;
+    delete[] _odd;
+    delete[] _accumulator;
+}
+
+/* public methods */
+
+template <typename SampleType>
+void HalfBandFilter<SampleType>::resize( int amountOfChannels, int maxLength )
+{
+    if ( _amountOfChannels == amountOfChannels && _maxLength == maxLength )
+        return;
+
+    _amountOfChannels = amountOfChannels;
+    _maxLength        = maxLength;
+
+    delete[] _even;
+    delete[] _odd;
+    delete[] _accumulator;
+
+    int workSize = ( _historyLength + _maxLength ) * _amountOfChannels;
+
+    _even        = new SampleType[ workSize ];
+    _odd         = new SampleType[ workSize ];
+    _accumulator = new SampleType[ _maxLength * _amountOfChannels ];
+
+    clear();
+}
+
+template <typename SampleType>
+void HalfBandFilter<SampleType>::clear()
+{
+    memset( _even, 0, _historyLength * _amountOfChannels * sizeof( SampleType ));
+    memset( _odd,  0, _historyLength * _amountOfChannels * sizeof( SampleType ));
+}
+
+template <typename SampleType>
+void HalfBandFilter<SampleType>::upsample( const SampleType* inputBuffer, SampleType* outputBuffer, int numChannels, int length )
+{
+    int K = _numCoefficients;
+
+    memcpy( _even + _historyLength * numChannels, inputBuffer, length * numChannels * sizeof( SampleType ));
+
+    convolve( _even, numChannels, length * numChannels );
+
+    // the even frames are the convolution output (doubled to compensate for the energy of the
+    // zero valued frames inserted between the input frames), the odd frames are the input at the center tap
+
+    const SampleType* center = _even + K * numChannels;
+
+    for ( int i = 0; i < length; ++i ) {
+        SampleType* evenFrame = outputBuffer + ( i * 2 ) * numChannels;
+        SampleType* oddFrame  = evenFrame + numChannels;
+
+        for ( int c = 0; c < numChannels; ++c ) {
+            evenFrame[ c ] = _accumulator[ i * numChannels + c ] * ( SampleType ) 2;
+            oddFrame[ c ]  = center[ i * numChannels + c ];
+        }
+    }
+    updateHistory( _even, numChannels, length );
+}
+
+template <typename SampleType>
+void HalfBandFilter<SampleType>::downsample( const SampleType* inputBuffer, SampleType* outputBuffer, int numChannels, int length )
+{
+    int K = _numCoefficients;
+
+    // split the input into its even and odd frames (e.g. the polyphase components)
+
+    SampleType* even = _even + _historyLength * numChannels;
+    SampleType* odd  = _odd  + _historyLength * numChannels;
+
+    for ( int i = 0; i < length; ++i ) {
+        const SampleType* evenFrame = inputBuffer + ( i * 2 ) * numChannels;
+        const SampleType* oddFrame  = evenFrame + numChannels;
+
+        for ( int c = 0; c < numChannels; ++c ) {
+            even[ i * numChannels + c ] = evenFrame[ c ];
+            odd[ i * numChannels + c ]  = oddFrame[ c ];
+        }
+    }
+
+    convolve( _even, numChannels, length * numChannels );
+
+    // add the odd frames at the center coefficient
+
+    const SampleType* center = _odd + ( K - 1 ) * numChannels;
+    int numSamples = length * numChannels;
+
+    for ( int i = 0; i < numSamples; ++i ) {
+        outputBuffer[ i ] = _accumulator[ i ] + center[ i ] * ( SampleType ) .5;
+    }
+    updateHistory( _even, numChannels, length );
+    updateHistory( _odd,  numChannels, length );
+}
+
+template <typename SampleType>
+double HalfBandFilter<SampleType>::getLatency()
+{
+    // the center of the filter lies ( taps - 1 ) / 2 frames behind the most recent frame at the
+    // higher rate, which is half that amount at the lower rate
+
+    return ( double ) _historyLength / 2.0;
+}
+
+/* private methods */
+
+template <typename SampleType>
+void HalfBandFilter<SampleType>::convolve( const SampleType* workBuffer, int numChannels, int numSamples )
+{
+    int K = _numCoefficients;
+    SampleType* accumulator = _accumulator;
+
+    // each coefficient is applied onto a pair of frames symmetrically positioned around the center
+    // as the work buffer holds interleaved frames, these are offset by full frames (e.g. numChannels samples)
+
+    for ( int k = 0; k < K; ++k ) {
+        const SampleType coefficient = _coefficients[ k ];
+        const SampleType* newer = workBuffer + ( K + k ) * numChannels;
+        const SampleType* older = workBuffer + ( K - 1 - k ) * numChannels;
+
+        if ( k == 0 ) {
+            for ( int i = 0; i < numSamples; ++i ) {
+                accumulator[ i ] = coefficient * ( newer[ i ] + older[ i ]);
+            }
+        }
+        else {
+            for ( int i = 0; i < numSamples; ++i ) {
+                accumulator[ i ] += coefficient * ( newer[ i ] + older[ i ]);
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void HalfBandFilter<SampleType>::updateHistory( SampleType* workBuffer, int numChannels, int length )
+{
+    memmove( workBuffer, workBuffer + length * numChannels, _historyLength * numChannels * sizeof( SampleType ));
+}
+
+template <typename SampleType>
+double HalfBandFilter<SampleType>::besselI0( double x )
+{
+    // power series, converges quickly for the range of values used by the Kaiser window
+
+    double sum  = 1.0;
+    double term = 1.0;
+    double half = x / 2.0;
+
+    for ( int k = 1; k < 50; ++k ) {
+        term *= ( half / k ) * ( half / k );
+        sum  += term;
+
+        if ( term < sum * 1e-12 )
+            break;
+    }
+    return sum;
+}
+
+}
@@ -0,0 +1,165 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "kernels.h"
+#include <atomic>
+
+#if defined( KERNELS_X86 ) && defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace Igorski {
+namespace Kernels {
+
+// the selected tables, these are replaced as a whole (e.g. processing threads
+// never observe a mix of kernels for different instruction sets)
+
+static std::atomic<const Table<float>*>  floatTable ( Scalar::getTable<float>() );
+static std::atomic<const Table<double>*> doubleTable( Scalar::getTable<double>() );
+static std::atomic<int> selectedArchitecture( Architecture::SCALAR );
+
+void initialize()
+{
+    select( detect() );
+}
+
+bool select( Architecture::Type architecture )
+{
+    if ( !isSupported( architecture ))
+        return false;
+
+    floatTable.store ( getTable<float>( architecture ),  std::memory_order_relaxed );
+    doubleTable.store( getTable<double>( architecture ), std::memory_order_relaxed );
+    selectedArchitecture.store( architecture, std::memory_order_relaxed );
+
+    return true;
+}
+
+Architecture::Type detect()
+{
+#if defined( KERNELS_X86 )
+#if defined( _MSC_VER )
+    // AVX registers must also be enabled by the operating system (XCR0 OS support flags)
+
+    int info[ 4 ];
+    __cpuid( info, 0 );
+    int maxLeaf = info[ 0 ];
+
+    __cpuid( info, 1 );
+    bool hasXSave = ( info[ 2 ] & ( 1 << 27 )) != 0;
+    bool hasAVX   = ( info[ 2 ] & ( 1 << 28 )) != 0;
+    bool hasSSE2  = ( info[ 3 ] & ( 1 << 26 )) != 0;
+
+    unsigned long long xcr0 = hasXSave ? _xgetbv( 0 ) : 0;
+    bool hasAVX2 = false, hasAVX512 = false;
+
+    if ( maxLeaf >= 7 ) {
+        __cpuidex( info, 7, 0 );
+        hasAVX2   = hasAVX && ( info[ 1 ] & ( 1 << 5 ))  != 0 && ( xcr0 & 0x6 )  == 0x6;
+        hasAVX512 = hasAVX && ( info[ 1 ] & ( 1 << 16 )) != 0 && ( xcr0 & 0xE6 ) == 0xE6;
+    }
+#else
+    // these also verify the AVX registers are enabled by the operating system
+
+    __builtin_cpu_init();
+
+    bool hasSSE2   = __builtin_cpu_supports( "sse2" );
+    bool hasAVX2   = __builtin_cpu_supports( "avx2" );
+    bool hasAVX512 = __builtin_cpu_supports( "avx512f" );
+#endif
+    if ( hasAVX512 ) return Architecture::AVX512;
+    if ( hasAVX2 )   return Architecture::AVX2;
+    if ( hasSSE2 )   return Architecture::SSE2;
+
+#elif defined( KERNELS_NEON )
+    return Architecture::NEON;
+#endif
+    return Architecture::SCALAR;
+}
+
+bool isSupported( Architecture::Type architecture )
+{
+    if ( getTable<float>( architecture ) == nullptr )
+        return false;
+
+    // the x86 instruction sets are supersets of their predecessors
+
+    switch ( architecture ) {
+        case Architecture::SSE2:
+        case Architecture::AVX2:
+        case Architecture::AVX512:
+        {
+            Architecture::Type detected = detect();
+            return detected != Architecture::SCALAR && architecture <= detected;
+        }
+        default:
+            return true;
+    }
+}
+
+Architecture::Type getArchitecture()
+{
+    return ( Architecture::Type ) selectedArchitecture.load( std::memory_order_relaxed );
+}
+
+const char* getArchitectureName( Architecture::Type architecture )
+{
+    switch ( architecture ) {
+        default:
+        case Architecture::SCALAR: return "scalar";
+        case Architecture::SSE2:   return "SSE2";
+        case Architecture::AVX2:   return "AVX2";
+        case Architecture::AVX512: return "AVX-512";
+        case Architecture::NEON:   return "NEON";
+    }
+}
+
+template <>
+const Table<float>& get<float>()
+{
+    return *floatTable.load( std::memory_order_relaxed );
+}
+
+template <>
+const Table<double>& get<double>()
+{
+    return *doubleTable.load( std::memory_order_relaxed );
+}
+
+template <typename SampleType>
+const Table<SampleType>* getTable( Architecture::Type architecture )
+{
+    switch ( architecture ) {
+        case Architecture::SCALAR: return Scalar::getTable<SampleType>();
+        case Architecture::SSE2:   return SSE2::getTable<SampleType>();
+        case Architecture::AVX2:   return AVX2::getTable<SampleType>();
+        case Architecture::AVX512: return AVX512::getTable<SampleType>();
+        case Architecture::NEON:   return NEON::getTable<SampleType>();
+        default:                   return nullptr;
+    }
+}
+
+template const Table<float>*  getTable<float>( Architecture::Type architecture );
+template const Table<double>* getTable<double>( Architecture::Type architecture );
+
+}
+}
@@ -0,0 +1,143 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __KERNELS_H_INCLUDED__
+#define __KERNELS_H_INCLUDED__
+
+#include <limits.h>
+
+/**
+ * Kernels are the innermost loops of the DSP classes (e.g. mixing, crushing and filtering
+ * runs of samples). Their implementation (see kernels.tcc) is compiled once for each supported
+ * instruction set into a table of function pointers (see the kernels_*.cpp sources). initialize()
+ * selects the table for the most capable instruction set of the executing CPU, as such a single
+ * binary runs the best code path on each machine.
+ *
+ * All variants perform the same operations in the same order (floating point contraction is
+ * disabled for the kernel sources) and thus produce identical output to the SCALAR reference.
+ */
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#define KERNELS_X86
+#elif defined( __aarch64__ ) || defined( _M_ARM64 ) || defined( __ARM_NEON )
+#define KERNELS_NEON
+#endif
+
+namespace Igorski {
+namespace Kernels {
+
+    // the instruction sets kernels are compiled for (in order of capability within each CPU family)
+
+    namespace Architecture {
+        enum Type {
+            SCALAR = 0, // portable reference, compiled without vectorization
+            SSE2,
+            AVX2,
+            AVX512,
+            NEON,
+            COUNT
+        };
+    }
+
+    template <typename SampleType>
+    struct Table {
+
+        // add the delayed frames multiplied by their per frame feedback onto given interleaved frames
+        // returns the highest absolute sample value of the result
+
+        SampleType ( *applyFeedback )( SampleType* frames, const SampleType* delayedFrames, const float* feedback,
+                                       int numChannels, int amountOfFrames );
+
+        // write the mix of a wet and a dry channel into given output, mix being the per sample wet amount
+        // (the strides are in samples, e.g. the amount of channels when reading from interleaved frames)
+        // the output can be the dry channel (as some hosts supply the same buffer for in- and output)
+
+        void ( *mixWetDry )( SampleType* output, const SampleType* wet, int wetStride, const SampleType* dry, int dryStride,
+                             const float* mix, int length );
+
+        // reduce the resolution of given samples to given amount of bits (1 - 16)
+
+        void ( *crush )( SampleType* samples, int length, int bits, SampleType inputMix, SampleType outputMix );
+
+        // apply a biquad filter with given coefficients onto given interleaved frames, updating
+        // the filter state of each channel (the previous in- and output samples)
+
+        void ( *biquad )( SampleType* frames, int numChannels, int amountOfFrames,
+                          SampleType a1, SampleType a2, SampleType a3, SampleType b1, SampleType b2,
+                          SampleType* in1, SampleType* in2, SampleType* out1, SampleType* out2 );
+
+        // apply the linked gain reduction of the Limiter onto given channels, returns the gain at the end of the buffers
+
+        SampleType ( *limit )( SampleType** channels, int numChannels, int length, SampleType gain, SampleType threshold,
+                               SampleType attack, SampleType release, SampleType trim, bool softKnee );
+
+        // AudioBuffer operations
+
+        void ( *scale )( SampleType* samples, int length, SampleType amount );
+        void ( *mix )( SampleType* target, const SampleType* source, int length, SampleType volume );
+        bool ( *isZero )( const SampleType* samples, int length );
+    };
+
+    // select the kernels for the most capable instruction set of the executing CPU
+    // this should be invoked when initializing (e.g. not while processing)
+
+    void initialize();
+
+    // select the kernels for given instruction set, returns false (keeping the current selection)
+    // when these are not supported (see isSupported()). This should not be invoked while processing
+
+    bool select( Architecture::Type architecture );
+
+    // the most capable instruction set supported by the executing CPU (and operating system)
+
+    Architecture::Type detect();
+
+    // whether the kernels for given instruction set are compiled into this binary and can execute on this CPU
+
+    bool isSupported( Architecture::Type architecture );
+
+    Architecture::Type getArchitecture();
+    const char* getArchitectureName( Architecture::Type architecture );
+
+    // the kernels of the selected instruction set (the SCALAR reference until initialized)
+
+    template <typename SampleType>
+    const Table<SampleType>& get();
+
+    template <> const Table<float>&  get<float>();
+    template <> const Table<double>& get<double>();
+
+    // the kernels for given instruction set, null when these are not compiled into this binary
+
+    template <typename SampleType>
+    const Table<SampleType>* getTable( Architecture::Type architecture );
+
+    // the kernel tables for each instruction set (see kernels_*.cpp)
+
+    namespace Scalar { template <typename SampleType> const Table<SampleType>* getTable(); }
+    namespace SSE2   { template <typename SampleType> const Table<SampleType>* getTable(); }
+    namespace AVX2   { template <typename SampleType> const Table<SampleType>* getTable(); }
+    namespace AVX512 { template <typename SampleType> const Table<SampleType>* getTable(); }
+    namespace NEON   { template <typename SampleType> const Table<SampleType>* getTable(); }
+}
+}
+
+#endif
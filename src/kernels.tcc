@@ -0,0 +1,249 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * The kernel implementations, included by each of the kernels_*.cpp sources within the
+ * namespace of their instruction set (for which the compiler generates the code)
+ *
+ * The kernels are written as plain loops over contiguous memory for the compiler to vectorize
+ * and do not call any (inline) functions, as these could otherwise be compiled for an instruction
+ * set that is not supported by all CPUs and end up being shared with the other variants
+ */
+
+// as the frame loops are specialized for the common (mono and stereo) channel
+// counts, CHANNELS is the amount of channels or 0 when it is provided at runtime
+
+template <typename SampleType, int CHANNELS>
+SampleType applyFeedbackFrames( SampleType* frames, const SampleType* delayedFrames, const float* feedback,
+                                int numChannels, int amountOfFrames )
+{
+    const int channels = CHANNELS > 0 ? CHANNELS : numChannels;
+    SampleType peak = 0;
+
+    for ( int i = 0; i < amountOfFrames; ++i ) {
+        SampleType frameFeedback = feedback[ i ];
+
+        for ( int c = 0; c < channels; ++c ) {
+            SampleType sample = frames[ i * channels + c ] + delayedFrames[ i * channels + c ] * frameFeedback;
+            SampleType level  = sample < 0 ? -sample : sample;
+
+            frames[ i * channels + c ] = sample;
+            peak = level > peak ? level : peak;
+        }
+    }
+    return peak;
+}
+
+template <typename SampleType>
+SampleType applyFeedback( SampleType* frames, const SampleType* delayedFrames, const float* feedback,
+                          int numChannels, int amountOfFrames )
+{
+    switch ( numChannels ) {
+        case 1:
+            return applyFeedbackFrames<SampleType, 1>( frames, delayedFrames, feedback, numChannels, amountOfFrames );
+        case 2:
+            return applyFeedbackFrames<SampleType, 2>( frames, delayedFrames, feedback, numChannels, amountOfFrames );
+        default:
+            return applyFeedbackFrames<SampleType, 0>( frames, delayedFrames, feedback, numChannels, amountOfFrames );
+    }
+}
+
+template <typename SampleType>
+void mixWetDry( SampleType* output, const SampleType* wet, int wetStride, const SampleType* dry, int dryStride,
+                const float* mix, int length )
+{
+    for ( int i = 0; i < length; ++i ) {
+
+        // the dry sample is read before the output is written (as these can share the same buffer)
+        SampleType drySample = dry[ i * dryStride ];
+        float wetMix         = mix[ i ];
+
+        output[ i ] = wet[ i * wetStride ] * wetMix + ( drySample * ( SampleType ) ( 1.f - wetMix ));
+    }
+}
+
+template <typename SampleType>
+void crush( SampleType* samples, int length, int bits, SampleType inputMix, SampleType outputMix )
+{
+    short preventOffset = ( short )( -1 >> ( bits + 1 ));
+    short mask          = ( short )( 0xFFFF << ( 16 - bits ));
+
+    for ( int i = 0; i < length; ++i ) {
+        short input = ( short )( int )(( samples[ i ] * inputMix ) * SHRT_MAX );
+        input &= mask;
+        samples[ i ] = (( input + preventOffset ) * outputMix ) / SHRT_MAX;
+    }
+}
+
+template <typename SampleType, int CHANNELS>
+void biquadFrames( SampleType* frames, int numChannels, int amountOfFrames,
+                   SampleType a1, SampleType a2, SampleType a3, SampleType b1, SampleType b2,
+                   SampleType* in1, SampleType* in2, SampleType* out1, SampleType* out2 )
+{
+    const int channels = CHANNELS > 0 ? CHANNELS : numChannels;
+
+    for ( int i = 0; i < amountOfFrames; ++i ) {
+        SampleType* frame = frames + i * channels;
+
+        for ( int c = 0; c < channels; ++c ) {
+            SampleType input  = frame[ c ];
+            SampleType output = a1 * input + a2 * in1[ c ] + a3 * in2[ c ] - b1 * out1[ c ] - b2 * out2[ c ];
+
+            in2 [ c ] = in1[ c ];
+            in1 [ c ] = input;
+            out2[ c ] = out1[ c ];
+            out1[ c ] = output;
+
+            frame[ c ] = output;
+        }
+    }
+}
+
+template <typename SampleType>
+void biquad( SampleType* frames, int numChannels, int amountOfFrames,
+             SampleType a1, SampleType a2, SampleType a3, SampleType b1, SampleType b2,
+             SampleType* in1, SampleType* in2, SampleType* out1, SampleType* out2 )
+{
+    // the output of each frame depends on the previous frames, as such the
+    // channels of each frame (rather than subsequent frames) are processed in parallel
+
+    switch ( numChannels ) {
+        case 1:
+            biquadFrames<SampleType, 1>( frames, numChannels, amountOfFrames, a1, a2, a3, b1, b2, in1, in2, out1, out2 );
+            break;
+        case 2:
+            biquadFrames<SampleType, 2>( frames, numChannels, amountOfFrames, a1, a2, a3, b1, b2, in1, in2, out1, out2 );
+            break;
+        default:
+            biquadFrames<SampleType, 0>( frames, numChannels, amountOfFrames, a1, a2, a3, b1, b2, in1, in2, out1, out2 );
+            break;
+    }
+}
+
+// the level the linked limiter detects for given frame. A stereo pair is detected on the sum of both
+// channels and a mono channel as is. Wider layouts are detected on their loudest channel scaled to the sum of
+// an in phase stereo pair. As such the level does not grow with the amount of channels, nor do channels in
+// opposite phase cancel out
+
+template <typename SampleType>
+inline SampleType detectLevel( SampleType** channels, int numChannels, int i )
+{
+    if ( numChannels == 1 )
+        return channels[ 0 ][ i ] < 0 ? -channels[ 0 ][ i ] : channels[ 0 ][ i ];
+
+    if ( numChannels == 2 ) {
+        SampleType sum = channels[ 0 ][ i ] + channels[ 1 ][ i ];
+        return sum < 0 ? -sum : sum;
+    }
+
+    SampleType peak = 0;
+
+    for ( int c = 0; c < numChannels; ++c ) {
+        SampleType sample = channels[ c ][ i ] < 0 ? -channels[ c ][ i ] : channels[ c ][ i ];
+        peak = sample > peak ? sample : peak;
+    }
+    return peak * 2;
+}
+
+template <typename SampleType>
+SampleType limit( SampleType** channels, int numChannels, int length, SampleType gain, SampleType threshold,
+                  SampleType attack, SampleType release, SampleType trim, bool softKnee )
+{
+    SampleType g = gain, level, lev;
+
+    // the limiter is linked: the level is detected across all channels (see detectLevel())
+    // and the resulting gain reduction is applied equally to each channel
+
+    if ( softKnee )
+    {
+        for ( int i = 0; i < length; ++i ) {
+
+            level = detectLevel( channels, numChannels, i );
+            lev   = ( SampleType ) ( 1.f / ( 1.f + threshold * level ));
+
+            if ( g > lev ) {
+                g = g - attack * ( g - lev );
+            }
+            else {
+                g = g + release * ( lev - g );
+            }
+
+            for ( int c = 0; c < numChannels; ++c )
+                channels[ c ][ i ] = ( channels[ c ][ i ] * trim * g );
+        }
+    }
+    else
+    {
+        for ( int i = 0; i < length; ++i ) {
+
+            level = detectLevel( channels, numChannels, i );
+            lev   = ( SampleType ) ( 0.5 * g * level );
+
+            if ( lev > threshold ) {
+                g = g - ( attack * ( lev - threshold ));
+            }
+            else {
+                // below threshold
+                g = g + ( SampleType )( release * ( 1.f - g ));
+            }
+
+            for ( int c = 0; c < numChannels; ++c )
+                channels[ c ][ i ] = ( channels[ c ][ i ] * trim * g );
+        }
+    }
+    return g;
+}
+
+template <typename SampleType>
+void scale( SampleType* samples, int length, SampleType amount )
+{
+    for ( int i = 0; i < length; ++i )
+        samples[ i ] *= amount;
+}
+
+template <typename SampleType>
+void mix( SampleType* target, const SampleType* source, int length, SampleType volume )
+{
+    for ( int i = 0; i < length; ++i )
+        target[ i ] += ( source[ i ] * volume );
+}
+
+template <typename SampleType>
+bool isZero( const SampleType* samples, int length )
+{
+    // no early exit, as the loop can then be vectorized
+
+    bool hasSignal = false;
+
+    for ( int i = 0; i < length; ++i )
+        hasSignal |= samples[ i ] != 0;
+
+    return !hasSignal;
+}
+
+// the kernels in the order of the Table members (see getTable() in the kernels_*.cpp sources)
+
+#define KERNELS_TABLE( SampleType ) { \
+    applyFeedback<SampleType>, mixWetDry<SampleType>, crush<SampleType>, biquad<SampleType>, \
+    limit<SampleType>, scale<SampleType>, mix<SampleType>, isZero<SampleType> \
+}
@@ -0,0 +1,57 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "kernels.h"
+
+/**
+ * the kernels compiled for NEON, which is part of the ARM64 baseline
+ * (on 32-bit ARM these are only compiled when the build targets NEON)
+ */
+#if defined( KERNELS_NEON )
+#define KERNELS_COMPILED
+#endif
+
+namespace Igorski {
+namespace Kernels {
+namespace NEON {
+
+#if defined( KERNELS_COMPILED )
+#include "kernels.tcc"
+#endif
+
+template <typename SampleType>
+const Table<SampleType>* getTable()
+{
+#if defined( KERNELS_COMPILED )
+    static const Table<SampleType> table = KERNELS_TABLE( SampleType );
+    return &table;
+#else
+    return nullptr; // not supported by the target platform
+#endif
+}
+
+template const Table<float>*  getTable<float>();
+template const Table<double>* getTable<double>();
+
+}
+}
+}
@@ -0,0 +1,84 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "kernels.h"
+
+/**
+ * the kernels compiled for SSE2, the baseline of x86-64 CPUs
+ */
+#if defined( KERNELS_X86 )
+#define KERNELS_COMPILED
+#endif
+
+#if defined( KERNELS_COMPILED )
+#if defined( __clang__ )
+#pragma clang attribute push( __attribute__(( target( "sse2" ))), apply_to = function )
+#elif defined( __GNUC__ )
+#pragma GCC push_options
+#pragma GCC target( "sse2" )
+#endif
+#endif
+
+namespace Igorski {
+namespace Kernels {
+namespace SSE2 {
+
+#if defined( KERNELS_COMPILED )
+#include "kernels.tcc"
+#endif
+
+}
+}
+}
+
+#if defined( KERNELS_COMPILED )
+#if defined( __clang__ )
+#pragma clang attribute pop
+#elif defined( __GNUC__ )
+#pragma GCC pop_options
+#endif
+#endif
+
+namespace Igorski {
+namespace Kernels {
+namespace SSE2 {
+
+// the table is defined outside of the target region, as it is retrieved before it is known
+// whether the CPU supports the instruction set (e.g. it should not execute any of its instructions)
+
+template <typename SampleType>
+const Table<SampleType>* getTable()
+{
+#if defined( KERNELS_COMPILED )
+    static const Table<SampleType> table = KERNELS_TABLE( SampleType );
+    return &table;
+#else
+    return nullptr; // not supported by the target platform
+#endif
+}
+
+template const Table<float>*  getTable<float>();
+template const Table<double>* getTable<double>();
+
+}
+}
+}
@@ -26,31 +26,32 @@
 #include "global.h"
 
 namespace Igorski {
+template <typename SampleType>
 class LFO {
 
     public:
         LFO();
         ~LFO();
 
-        float getRate();
-        void setRate( float value );
+        SampleType getRate();
+        void setRate( SampleType value );
 
         // accumulators are used to retrieve a sample from the wave table
         // in other words: track the progress of the oscillator against its range
 
-        float getAccumulator();
-        void setAccumulator( float offset );
+        SampleType getAccumulator();
+        void setAccumulator( SampleType offset );
 
         /**
          * retrieve a value from the wave table for the current
          * accumulator position, this method also increments
          * the accumulator and keeps it within bounds
          */
-        inline float peek()
+        inline SampleType peek()
         {
             // the wave table offset to read from
-            float SR_OVER_LENGTH = VST::SAMPLE_RATE / ( float ) TABLE_SIZE;
-            int readOffset = ( _accumulator == 0.f ) ? 0 : ( int ) ( _accumulator / SR_OVER_LENGTH );
+            SampleType SR_OVER_LENGTH = VST::SAMPLE_RATE / ( SampleType ) TABLE_SIZE;
+            int readOffset = ( _accumulator == 0 ) ? 0 : ( int ) ( _accumulator / SR_OVER_LENGTH );
 
             // increment the accumulators read offset
             _accumulator += _rate;
@@ -60,7 +61,7 @@ class LFO {
                 _accumulator -= VST::SAMPLE_RATE;
 
             // return the sample present at the calculated offset within the table
-            return VST::TABLE[ readOffset ];
+            return ( SampleType ) VST::TABLE[ readOffset ];
         }
 
     private:
@@ -70,9 +71,11 @@ class LFO {
 
         // used internally
 
-        float _rate;
-        float _accumulator;   // is read offset in wave table buffer
+        SampleType _rate;
+        SampleType _accumulator;   // is read offset in wave table buffer
 };
 }
 
+#include "lfo.tcc"
+
 #endif
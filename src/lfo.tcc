@@ -20,37 +20,41 @@
  * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
-#include "lfo.h"
-
 namespace Igorski {
 
-LFO::LFO() {
+template <typename SampleType>
+LFO<SampleType>::LFO() {
     _rate        = VST::MIN_LFO_RATE();
-    _accumulator = 0.f;
+    _accumulator = 0;
 }
 
-LFO::~LFO() {
+template <typename SampleType>
+LFO<SampleType>::~LFO() {
 
 }
 
 /* public methods */
 
-float LFO::getRate()
+template <typename SampleType>
+SampleType LFO<SampleType>::getRate()
 {
     return _rate;
 }
 
-void LFO::setRate( float value )
+template <typename SampleType>
+void LFO<SampleType>::setRate( SampleType value )
 {
     _rate = value;
 }
 
-void LFO::setAccumulator( float value )
+template <typename SampleType>
+void LFO<SampleType>::setAccumulator( SampleType value )
 {
     _accumulator = value;
 }
 
-float LFO::getAccumulator()
+template <typename SampleType>
+SampleType LFO<SampleType>::getAccumulator()
 {
     return _accumulator;
 }
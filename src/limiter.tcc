@@ -32,65 +32,10 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
 //        return;
 //    }
 
-    SampleType g, at, re, tr, th, lev, ol, or_;
+    // the limiter is linked: the level is detected across all channels (see Kernels::detectLevel())
+    // and the resulting gain reduction is applied equally to each channel
 
-    th = thresh;
-    g = gain;
-    at = att;
-    re = rel;
-    tr = trim;
-
-    bool hasRight = ( numOutChannels > 1 );
-
-    SampleType* leftBuffer  = outputBuffer[ 0 ];
-    SampleType* rightBuffer = hasRight ? outputBuffer[ 1 ] : 0;
-
-    if ( pKnee > 0.5 )
-    {
-        // soft knee
-
-        for ( int i = 0; i < bufferSize; ++i ) {
-
-            ol  = leftBuffer[ i ];
-            or_ = hasRight ? rightBuffer[ i ] : 0;
-
-            lev = ( SampleType ) ( 1.f / ( 1.f + th * fabs( ol + or_ )));
-
-            if ( g > lev ) {
-                g = g - at * ( g - lev );
-            }
-            else {
-                g = g + re * ( lev - g );
-            }
-
-            leftBuffer[ i ] = ( ol * tr * g );
-
-            if ( hasRight )
-                rightBuffer[ i ] = ( or_ * tr * g );
-        }
-    }
-    else
-    {
-        for ( int i = 0; i < bufferSize; ++i ) {
-
-            ol  = leftBuffer[ i ];
-            or_ = hasRight ? rightBuffer[ i ] : 0;
-
-            lev = ( SampleType ) ( 0.5 * g * fabs( ol + or_ ));
-
-            if ( lev > th ) {
-                g = g - ( at * ( lev - th ));
-            }
-            else {
-                // below threshold
-                g = g + ( SampleType )( re * ( 1.f - g ));
-            }
-
-            leftBuffer[ i ] = ( ol * tr * g );
-
-            if ( hasRight )
-                rightBuffer[ i ] = ( or_ * tr * g );
-        }
-    }
-    gain = g;
+    gain = ( float ) Igorski::Kernels::get<SampleType>().limit(
+        outputBuffer, numOutChannels, bufferSize, gain, thresh, att, rel, trim, pKnee > 0.5
+    );
 }
@@ -0,0 +1,267 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+namespace Igorski {
+
+static int64_t getTime()
+{
+    return ( int64_t ) std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+}
+
+/* LogQueue */
+
+LogQueue::LogQueue()
+{
+    _writeIndex.store( 0 );
+    _readIndex.store( 0 );
+    _dropped.store( 0 );
+
+    Logger::registerQueue( this );
+}
+
+LogQueue::~LogQueue()
+{
+    Logger::unregisterQueue( this );
+}
+
+bool LogQueue::log( const char* format, ... )
+{
+    uint32_t writeIndex = _writeIndex.load( std::memory_order_relaxed );
+
+    if ( writeIndex - _readIndex.load( std::memory_order_acquire ) >= ( uint32_t ) CAPACITY ) {
+        _dropped.fetch_add( 1, std::memory_order_relaxed );
+        return false;
+    }
+
+    // the message is formatted directly into its slot of the ring
+
+    Message& message = _messages[ writeIndex & ( CAPACITY - 1 )];
+    message.time = getTime();
+
+    va_list arguments;
+    va_start( arguments, format );
+    vsnprintf( message.text, MESSAGE_SIZE, format, arguments );
+    va_end( arguments );
+
+    _writeIndex.store( writeIndex + 1, std::memory_order_release );
+
+    return true;
+}
+
+bool LogQueue::pop( Message& message )
+{
+    uint32_t readIndex = _readIndex.load( std::memory_order_relaxed );
+
+    if ( readIndex == _writeIndex.load( std::memory_order_acquire ))
+        return false;
+
+    message = _messages[ readIndex & ( CAPACITY - 1 )];
+
+    _readIndex.store( readIndex + 1, std::memory_order_release );
+
+    return true;
+}
+
+uint32_t LogQueue::getDroppedMessages()
+{
+    return _dropped.exchange( 0, std::memory_order_relaxed );
+}
+
+/* Logger */
+
+namespace Logger {
+
+// the interval (in milliseconds) at which the background thread drains the queues
+
+static const int FLUSH_INTERVAL = 50;
+
+struct State {
+    std::mutex mutex; // guards all of the below (never acquired by a realtime thread)
+    std::condition_variable condition;
+    std::vector<LogQueue*> queues;
+    std::thread thread;
+    FILE* file = nullptr;
+    bool running = false;
+    uint32_t generation = 0; // incremented for each started thread
+};
+
+static State& getState()
+{
+    static State state;
+
+    // the output file can be provided by the environment, as the plugin has no means to configure it
+
+    static bool hasOutput = []( State& state ) {
+        const char* filename = getenv( "REGRADER_LOG_FILE" );
+
+        if ( filename != nullptr && filename[ 0 ] != '\0' )
+            state.file = fopen( filename, "a" );
+
+        return state.file != nullptr;
+    }( state );
+
+    ( void ) hasOutput;
+
+    return state;
+}
+
+// the following are invoked with the mutex held
+
+static void write( State& state, int64_t time, const char* text )
+{
+    char timestamp[ 32 ];
+    time_t seconds = ( time_t )( time / 1000 );
+    struct tm* utc = gmtime( &seconds );
+
+    strftime( timestamp, sizeof( timestamp ), "%Y-%m-%d %H:%M:%S", utc );
+
+    FILE* output = ( state.file != nullptr ) ? state.file : stderr;
+
+    fprintf( output, "%s.%03d %s\n", timestamp, ( int )( time % 1000 ), text );
+}
+
+static void drain( State& state )
+{
+    LogQueue::Message message;
+
+    for ( LogQueue* queue : state.queues ) {
+        while ( queue->pop( message )) {
+            write( state, message.time, message.text );
+        }
+        uint32_t dropped = queue->getDroppedMessages();
+
+        if ( dropped > 0 ) {
+            char text[ 64 ];
+            snprintf( text, sizeof( text ), "(dropped %u messages, the log queue was full)", dropped );
+            write( state, getTime(), text );
+        }
+    }
+    fflush( state.file != nullptr ? state.file : stderr );
+}
+
+static void run( uint32_t generation )
+{
+    State& state = getState();
+    std::unique_lock<std::mutex> lock( state.mutex );
+
+    // a thread that was stopped exits even when a new thread was started in the meantime
+
+    while ( state.running && state.generation == generation ) {
+        state.condition.wait_for( lock, std::chrono::milliseconds( FLUSH_INTERVAL ));
+        drain( state );
+    }
+}
+
+void setOutput( const char* filename )
+{
+    State& state = getState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    drain( state );
+
+    if ( state.file != nullptr )
+        fclose( state.file );
+
+    state.file = ( filename != nullptr ) ? fopen( filename, "a" ) : nullptr;
+}
+
+void log( const char* format, ... )
+{
+    char text[ LogQueue::MESSAGE_SIZE ];
+
+    va_list arguments;
+    va_start( arguments, format );
+    vsnprintf( text, sizeof( text ), format, arguments );
+    va_end( arguments );
+
+    State& state = getState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    // pending queued messages precede this message
+
+    drain( state );
+    write( state, getTime(), text );
+}
+
+void flush()
+{
+    State& state = getState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    drain( state );
+}
+
+void registerQueue( LogQueue* queue )
+{
+    State& state = getState();
+    std::lock_guard<std::mutex> lock( state.mutex );
+
+    state.queues.push_back( queue );
+
+    // the background thread runs for as long as queues are registered
+
+    if ( !state.running ) {
+        state.running = true;
+        state.thread  = std::thread( run, ++state.generation );
+    }
+}
+
+void unregisterQueue( LogQueue* queue )
+{
+    State& state = getState();
+    std::thread thread;
+
+    {
+        std::lock_guard<std::mutex> lock( state.mutex );
+
+        // write the remaining messages before the queue is gone
+
+        drain( state );
+        state.queues.erase( std::remove( state.queues.begin(), state.queues.end(), queue ), state.queues.end());
+
+        if ( state.queues.empty() && state.running ) {
+            state.running = false;
+            thread = std::move( state.thread );
+        }
+    }
+    state.condition.notify_all();
+
+    if ( thread.joinable() )
+        thread.join();
+}
+
+}
+}
@@ -0,0 +1,112 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __LOGGER_H_INCLUDED__
+#define __LOGGER_H_INCLUDED__
+
+#include "global.h"
+#include <atomic>
+
+/**
+ * Logging facility usable from the audio thread.
+ *
+ * A LogQueue is a lock-free single producer, single consumer ring of fixed size messages.
+ * Each realtime thread (e.g. each plugin instance, as a host can process instances on
+ * different threads) owns a LogQueue it formats its messages into. Writing a message does
+ * not allocate, lock or block, when the queue is full the message is dropped (and counted).
+ *
+ * The Logger drains all queues on a background thread and writes their messages to stderr
+ * or a file. Non realtime threads (e.g. the UI thread) log directly through Logger::log().
+ * The messages are written to the file named by the REGRADER_LOG_FILE environment variable
+ * when it is set (e.g. as a plugin its stderr is rarely visible), see also setOutput().
+ */
+namespace Igorski {
+class LogQueue
+{
+    public:
+        static const int MESSAGE_SIZE = 128; // in characters (including the terminator), longer messages are truncated
+        static const int CAPACITY     = 256; // in messages, must be a power of two
+
+        struct Message {
+            int64_t time; // in milliseconds since the epoch
+            char text[ MESSAGE_SIZE ];
+        };
+
+        // the queue registers itself with the Logger (as such it should not be created on the audio thread)
+
+        LogQueue();
+        ~LogQueue();
+
+        // format (printf style) and enqueue a message, returns false when the queue is full
+        // this is realtime safe when invoked from the (single) producing thread
+
+        bool log( const char* format, ... );
+
+        // dequeue the oldest message into given message, returns false when the queue is empty
+        // invoked by the (single) consuming thread
+
+        bool pop( Message& message );
+
+        // the amount of messages dropped since the previous invocation
+
+        uint32_t getDroppedMessages();
+
+    private:
+        Message _messages[ CAPACITY ];
+
+        std::atomic<uint32_t> _writeIndex; // only written by the producer
+        std::atomic<uint32_t> _readIndex;  // only written by the consumer
+        std::atomic<uint32_t> _dropped;
+};
+
+namespace Logger {
+
+    // write the messages to given file (appended to existing contents), or to stderr when null
+
+    void setOutput( const char* filename );
+
+    // log a message (printf style) from a non realtime thread, the message is written
+    // immediately (and thus not realtime safe, for the audio thread use a LogQueue)
+
+    void log( const char* format, ... );
+
+    // write all pending messages of the queues, this is invoked periodically
+    // by the background thread while queues are registered
+
+    void flush();
+
+    // (un)register a queue to be drained by the background thread (see LogQueue)
+
+    void registerQueue( LogQueue* queue );
+    void unregisterQueue( LogQueue* queue );
+}
+}
+
+// log from the audio thread in debug builds (compiled out otherwise, see CMakeLists.txt)
+
+#if defined( REGRADER_DEBUG_LOGGING )
+#define LOG_RT( queue, ... ) ( queue )->log( __VA_ARGS__ )
+#else
+#define LOG_RT( queue, ... )
+#endif
+
+#endif
@@ -22,6 +22,7 @@
  */
 #include "lowpassfilter.h"
 #include "global.h"
+#include "calc.h"
 #include <cmath>
 
 namespace Igorski {
@@ -61,22 +62,6 @@ void LowPassFilter::setCutoff( float value )
     x1 = x2 = y1 = y2 = 0;
 }
 
-void LowPassFilter::store()
-{
-    orgx1 = x1;
-    orgx2 = x2;
-    orgy1 = y1;
-    orgy2 = y2;
-}
-
-void LowPassFilter::restore()
-{
-    x1 = orgx1;
-    x2 = orgx2;
-    y1 = orgy1;
-    y2 = orgy2;
-}
-
 float LowPassFilter::processSingle( float sample )
 {
     float sampleOut = (b0/a0) * sample + (b1/a0) * x1 + (b2/a0) * x2 - (a1/a0) * y1 - (a2/a0) * y2;
@@ -84,7 +69,7 @@ float LowPassFilter::processSingle( float sample )
     x2 = x1;
     x1 = sample;
     y2 = y1;
-    y1 = sampleOut;
+    y1 = Calc::flushDenormal( sampleOut );
 
     return sampleOut;
 }
@@ -36,18 +36,10 @@ class LowPassFilter
         float getCutoff();
         void setCutoff( float value);
 
-        // store/restore the processor properties
-        // this ensures that multi channel processing for a
-        // single buffer uses all properties across all channels
-
-        void store();
-        void restore();
-
         float processSingle( float sample );
 
     protected:
         float x1, x2, y1, y2;
-        float orgx1, orgx2, orgy1, orgy2;
         float a0, a1, a2, b0, b1, b2, w0, alpha;
 
         float _cutoff;
@@ -0,0 +1,115 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __OVERSAMPLER_H_INCLUDED__
+#define __OVERSAMPLER_H_INCLUDED__
+
+#include "halfbandfilter.h"
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+/**
+ * Oversampler raises the sample rate of a block of interleaved frames by a factor of 2, 4 or 8
+ * (using a cascade of HalfBandFilters, each doubling the rate) so it can be processed by nonlinear
+ * effects (e.g. the BitCrusher and Decimator) without their harmonics folding back into the audible
+ * range, after which the block is lowpass filtered and brought back to the original rate.
+ *
+ * The first stage is the steepest as it defines the passband of the signal, subsequent stages
+ * operate on an already band limited signal and can have a wide transition band (and few coefficients).
+ *
+ * The combined latency of upsampling and downsampling is padded to an integer amount of frames at the
+ * original rate, so it can be compensated for (and reported to the host) exactly.
+ *
+ * All stages are created for the maximum factor, as such changing the factor does not allocate.
+ */
+namespace Igorski {
+template <typename SampleType>
+class Oversampler
+{
+    public:
+        static const int MAX_FACTOR = 8;
+
+        Oversampler( int amountOfChannels, int maxBufferSize );
+        ~Oversampler();
+
+        // (re)create the buffers for given amount of channels and maximum block length (in frames
+        // at the original rate). This allocates and should not be invoked while processing
+
+        void setAmountOfChannels( int amountOfChannels );
+        void setMaxBufferSize( int maxBufferSize );
+
+        // the oversampling factor (1, 2, 4 or 8), changing the factor clears the filter history
+
+        int getFactor();
+        void setFactor( int factor );
+
+        // clear the filter history
+
+        void clear();
+
+        // upsample given length of frames, returns the (internal) buffer holding the upsampled
+        // frames (e.g. length * getFactor() frames) which can be processed in place
+
+        SampleType* upsample( const SampleType* inputBuffer, int numChannels, int length );
+
+        // downsample the contents of the buffer returned by the last upsample() invocation
+        // into given length of frames in given output buffer
+
+        void downsample( SampleType* outputBuffer, int numChannels, int length );
+
+        // the combined latency of upsampling and downsampling (in frames at the original rate)
+        // for the current factor, or for given factor
+
+        int getLatency();
+        int getLatency( int factor );
+
+    private:
+        static const int MAX_STAGES = 3; // the amount of stages required for MAX_FACTOR
+
+        HalfBandFilter<SampleType>* _upsamplers[ MAX_STAGES ];
+        HalfBandFilter<SampleType>* _downsamplers[ MAX_STAGES ];
+
+        int _factor;
+        int _amountOfChannels;
+        int _maxBufferSize;
+
+        // the intermediate stages alternate between two buffers sized for the maximum factor
+
+        SampleType* _buffers[ 2 ];
+        int _outputBufferIndex; // index of the buffer holding the upsampled frames
+
+        // delay applied at the oversampled rate to pad the latency to an integer amount of frames
+
+        int _padLength;
+        SampleType* _padHistory;
+        SampleType* _padBuffer;
+
+        int getStageCount( int factor );
+        double getStageLatency( int factor );
+        void createBuffers();
+};
+}
+
+#include "oversampler.tcc"
+
+#endif
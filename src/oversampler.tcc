@@ -0,0 +1,249 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+/* constructor / destructor */
+
+template <typename SampleType>
+Oversampler<SampleType>::Oversampler( int amountOfChannels, int maxBufferSize )
+{
+    // the first stage has a narrow transition band (passing up to ~20 kHz at a 44.1 kHz rate), the
+    // subsequent stages only need to attenuate the images above the passband of the first stage
+
+    _upsamplers[ 0 ]   = new HalfBandFilter<SampleType>( 24, 90.0 );
+    _downsamplers[ 0 ] = new HalfBandFilter<SampleType>( 24, 90.0 );
+    _upsamplers[ 1 ]   = new HalfBandFilter<SampleType>( 6, 90.0 );
+    _downsamplers[ 1 ] = new HalfBandFilter<SampleType>( 6, 90.0 );
+    _upsamplers[ 2 ]   = new HalfBandFilter<SampleType>( 4, 80.0 );
+    _downsamplers[ 2 ] = new HalfBandFilter<SampleType>( 4, 80.0 );
+
+    _buffers[ 0 ]      = 0;
+    _buffers[ 1 ]      = 0;
+    _padHistory        = 0;
+    _padBuffer         = 0;
+    _outputBufferIndex = 0;
+    _padLength         = 0;
+    _factor            = 1;
+
+    _amountOfChannels = std::max( 1, amountOfChannels );
+    _maxBufferSize    = std::max( 1, maxBufferSize );
+
+    createBuffers();
+}
+
+template <typename SampleType>
+Oversampler<SampleType>::~Oversampler()
+{
+    for ( int s = 0; s < MAX_STAGES; ++s ) {
+        delete _upsamplers[ s ];
+        delete _downsamplers[ s ];
+    }
+    delete[] _buffers[ 0 ];
+    delete[] _buffers[ 1 ];
+    delete[] _padHistory;
+    delete[] _padBuffer;
+}
+
+/* public methods */
+
+template <typename SampleType>
+void Oversampler<SampleType>::setAmountOfChannels( int amountOfChannels )
+{
+    amountOfChannels = std::max( 1, amountOfChannels );
+
+    if ( _amountOfChannels == amountOfChannels )
+        return;
+
+    _amountOfChannels = amountOfChannels;
+
+    createBuffers();
+}
+
+template <typename SampleType>
+void Oversampler<SampleType>::setMaxBufferSize( int maxBufferSize )
+{
+    maxBufferSize = std::max( 1, maxBufferSize );
+
+    if ( _maxBufferSize == maxBufferSize )
+        return;
+
+    _maxBufferSize = maxBufferSize;
+
+    createBuffers();
+}
+
+template <typename SampleType>
+int Oversampler<SampleType>::getFactor()
+{
+    return _factor;
+}
+
+template <typename SampleType>
+void Oversampler<SampleType>::setFactor( int factor )
+{
+    // only powers of two up to MAX_FACTOR are supported
+
+    factor = ( factor >= 8 ) ? 8 : ( factor >= 4 ) ? 4 : ( factor >= 2 ) ? 2 : 1;
+
+    if ( _factor == factor )
+        return;
+
+    _factor    = factor;
+    _padLength = ( int ) round(( getLatency( factor ) - getStageLatency( factor )) * factor );
+
+    clear();
+}
+
+template <typename SampleType>
+void Oversampler<SampleType>::clear()
+{
+    for ( int s = 0; s < MAX_STAGES; ++s ) {
+        _upsamplers[ s ]->clear();
+        _downsamplers[ s ]->clear();
+    }
+    memset( _padHistory, 0, MAX_FACTOR * _amountOfChannels * sizeof( SampleType ));
+}
+
+template <typename SampleType>
+SampleType* Oversampler<SampleType>::upsample( const SampleType* inputBuffer, int numChannels, int length )
+{
+    int stages = getStageCount( _factor );
+
+    if ( stages == 0 ) {
+        _outputBufferIndex = 0;
+        memcpy( _buffers[ 0 ], inputBuffer, length * numChannels * sizeof( SampleType ));
+        return _buffers[ 0 ];
+    }
+
+    // each stage doubles the rate, writing into the buffer not used by the previous stage
+
+    const SampleType* stageInput = inputBuffer;
+    int index = 0;
+
+    for ( int s = 0; s < stages; ++s, index ^= 1 ) {
+        _upsamplers[ s ]->upsample( stageInput, _buffers[ index ], numChannels, length << s );
+        stageInput = _buffers[ index ];
+    }
+    _outputBufferIndex = index ^ 1;
+
+    return _buffers[ _outputBufferIndex ];
+}
+
+template <typename SampleType>
+void Oversampler<SampleType>::downsample( SampleType* outputBuffer, int numChannels, int length )
+{
+    int stages = getStageCount( _factor );
+    int index  = _outputBufferIndex;
+
+    if ( stages == 0 ) {
+        memcpy( outputBuffer, _buffers[ index ], length * numChannels * sizeof( SampleType ));
+        return;
+    }
+
+    // pad the latency by delaying the oversampled frames (the pad is shorter than the factor, and thus the block)
+
+    if ( _padLength > 0 ) {
+        SampleType* buffer = _buffers[ index ];
+        int padSamples     = _padLength * numChannels;
+        int numSamples     = ( length * _factor ) * numChannels;
+
+        memcpy ( _padBuffer, buffer + numSamples - padSamples, padSamples * sizeof( SampleType ));
+        memmove( buffer + padSamples, buffer, ( numSamples - padSamples ) * sizeof( SampleType ));
+        memcpy ( buffer, _padHistory, padSamples * sizeof( SampleType ));
+        memcpy ( _padHistory, _padBuffer, padSamples * sizeof( SampleType ));
+    }
+
+    // each stage halves the rate, the first stage writes into the output buffer
+
+    for ( int s = stages - 1; s >= 0; --s, index ^= 1 ) {
+        SampleType* stageOutput = ( s == 0 ) ? outputBuffer : _buffers[ index ^ 1 ];
+        _downsamplers[ s ]->downsample( _buffers[ index ], stageOutput, numChannels, length << s );
+    }
+}
+
+template <typename SampleType>
+int Oversampler<SampleType>::getLatency()
+{
+    return getLatency( _factor );
+}
+
+template <typename SampleType>
+int Oversampler<SampleType>::getLatency( int factor )
+{
+    // round up to the nearest frame (with some tolerance for rounding errors)
+
+    return ( int ) ceil( getStageLatency( factor ) - 1e-9 );
+}
+
+/* private methods */
+
+template <typename SampleType>
+int Oversampler<SampleType>::getStageCount( int factor )
+{
+    int stages = 0;
+
+    while (( 1 << stages ) < factor && stages < MAX_STAGES )
+        ++stages;
+
+    return stages;
+}
+
+template <typename SampleType>
+double Oversampler<SampleType>::getStageLatency( int factor )
+{
+    // each stage delays the signal when upsampling and again when downsampling, by an
+    // amount of frames at its lower rate (which for stage n is 2 ^ n times the original rate)
+
+    double latency = 0.0;
+
+    for ( int s = 0, l = getStageCount( factor ); s < l; ++s ) {
+        latency += _upsamplers[ s ]->getLatency() * 2.0 / ( double ) ( 1 << s );
+    }
+    return latency;
+}
+
+template <typename SampleType>
+void Oversampler<SampleType>::createBuffers()
+{
+    delete[] _buffers[ 0 ];
+    delete[] _buffers[ 1 ];
+    delete[] _padHistory;
+    delete[] _padBuffer;
+
+    int bufferSize = _maxBufferSize * MAX_FACTOR * _amountOfChannels;
+
+    _buffers[ 0 ] = new SampleType[ bufferSize ];
+    _buffers[ 1 ] = new SampleType[ bufferSize ];
+    _padHistory   = new SampleType[ MAX_FACTOR * _amountOfChannels ];
+    _padBuffer    = new SampleType[ MAX_FACTOR * _amountOfChannels ];
+
+    // each stage is sized for the amount of frames at its lower rate
+
+    for ( int s = 0; s < MAX_STAGES; ++s ) {
+        _upsamplers[ s ]->resize( _amountOfChannels, _maxBufferSize << s );
+        _downsamplers[ s ]->resize( _amountOfChannels, _maxBufferSize << s );
+    }
+    clear();
+}
+
+}
@@ -0,0 +1,94 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "parametermodel.h"
+#include <string.h>
+
+namespace Igorski {
+namespace ParameterModel {
+
+struct Definition {
+    const char* name;
+    float defaultValue;
+};
+
+// in order of the parameter ids
+
+static const Definition DEFINITIONS[ kNumParameters ] = {
+    { "delayTime",             .125f },
+    { "delayHostSync",         1.f   },
+    { "delayFeedback",         .2f   },
+    { "delayMix",              .5f   },
+    { "bitResolution",         1.f   },
+    { "bitResolutionChain",    1.f   },
+    { "bitResolutionLFO",      0.f   },
+    { "bitResolutionLFODepth", .75f  },
+    { "decimator",             1.f   },
+    { "decimatorChain",        0.f   },
+    { "decimatorLFO",          0.f   },
+    { "filterChain",           1.f   },
+    { "filterCutoff",          .5f   },
+    { "filterResonance",       1.f   },
+    { "filterLFO",             0.f   },
+    { "filterLFODepth",        .5f   },
+    { "flangerChain",          0.f   },
+    { "flangerRate",           0.f   },
+    { "flangerWidth",          0.f   },
+    { "flangerFeedback",       0.f   },
+    { "flangerDelay",          0.f   },
+    { "bypass",                0.f   },
+    { "oversampling",          0.f   }
+};
+
+const char* getName( int paramId )
+{
+    if ( paramId < 0 || paramId >= kNumParameters )
+        return nullptr;
+
+    return DEFINITIONS[ paramId ].name;
+}
+
+int getId( const char* name )
+{
+    for ( int paramId = 0; paramId < kNumParameters; ++paramId ) {
+        if ( !strcmp( DEFINITIONS[ paramId ].name, name ))
+            return paramId;
+    }
+    return -1;
+}
+
+float getDefaultValue( int paramId )
+{
+    if ( paramId < 0 || paramId >= kNumParameters )
+        return 0.f;
+
+    return DEFINITIONS[ paramId ].defaultValue;
+}
+
+void getDefaultValues( float* values )
+{
+    for ( int paramId = 0; paramId < kNumParameters; ++paramId )
+        values[ paramId ] = DEFINITIONS[ paramId ].defaultValue;
+}
+
+}
+}
@@ -0,0 +1,63 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __PARAMETERMODEL_H_INCLUDED__
+#define __PARAMETERMODEL_H_INCLUDED__
+
+#include "paramids.h"
+#include "regraderprocess.h"
+
+/**
+ * ParameterModel describes the plugin parameters (see paramids.h) as normalized (0 - 1 range)
+ * values and translates these onto a RegraderProcess. It is shared by the plugin and the tools
+ * that run the processor outside of a host (e.g. regrader-render), so both sound the same
+ */
+namespace Igorski {
+namespace ParameterModel {
+
+    // the name of given parameter (e.g. "delayTime") or null for an unknown id
+
+    const char* getName( int paramId );
+
+    // the id of the parameter with given name, or -1 when there is no such parameter
+
+    int getId( const char* name );
+
+    // the value given parameter has in a newly created plugin instance
+
+    float getDefaultValue( int paramId );
+
+    // fill given list of kNumParameters values with the defaults
+
+    void getDefaultValues( float* values );
+
+    // apply given list of kNumParameters normalized values (indexed by parameter id) onto given process
+    // using given quality profile. Note the bypass is not applied (this is up to the caller)
+
+    template <typename SampleType>
+    void apply( const float* values, RegraderProcess<SampleType>* process, const QualityProfile& profile );
+}
+}
+
+#include "parametermodel.tcc"
+
+#endif
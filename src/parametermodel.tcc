@@ -0,0 +1,60 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+namespace ParameterModel {
+
+template <typename SampleType>
+void apply( const float* values, RegraderProcess<SampleType>* process, const QualityProfile& profile )
+{
+    process->syncDelayToHost = Calc::toBool( values[ kDelayHostSyncId ]);
+    process->setDelayTime( values[ kDelayTimeId ]);
+    process->setDelayFeedback( values[ kDelayFeedbackId ]);
+    process->setDelayMix( values[ kDelayMixId ]);
+
+    process->bitCrusherPostMix = Calc::toBool( values[ kBitResolutionChainId ]);
+    process->decimatorPostMix  = Calc::toBool( values[ kDecimatorChainId ]);
+    process->filterPostMix     = Calc::toBool( values[ kFilterChainId ]);
+    process->flangerPostMix    = Calc::toBool( values[ kFlangerChainId ]);
+
+    process->bitCrusher->setAmount( values[ kBitResolutionId ]);
+    process->bitCrusher->setLFO( values[ kLFOBitResolutionId ], values[ kLFOBitResolutionDepthId ]);
+    process->decimator->setBits( ( int )( values[ kDecimatorId ] * 32.f ));
+    process->decimator->setRate( values[ kLFODecimatorId ]);
+    process->filter->updateProperties(
+        values[ kFilterCutoffId ], values[ kFilterResonanceId ], values[ kLFOFilterId ], values[ kLFOFilterDepthId ]
+    );
+
+    process->flanger->setRate( values[ kFlangerRateId ]);
+    process->flanger->setWidth( values[ kFlangerWidthId ]);
+    process->flanger->setFeedback( values[ kFlangerFeedbackId ]);
+    process->flanger->setDelay( values[ kFlangerDelayId ]);
+
+    // the oversampling factor is selected from four steps (off, 2x, 4x and 8x)
+
+    process->setOversamplingFactor( 1 << ( int ) round( values[ kOversamplingId ] * 3.f ));
+
+    process->setQualityProfile( profile );
+}
+
+}
+}
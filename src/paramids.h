@@ -55,6 +55,9 @@ enum
 
     // kVuPPMId                  // for the Vu value return to host
     kBypassId,                // bypass process (added in v1.0.5.1)
+    kOversamplingId,          // oversampling factor for the bit crusher and decimator
+
+    kNumParameters            // the total amount of parameters (keep last)
 };
 
 #endif
@@ -0,0 +1,121 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "profiler.h"
+#include <algorithm>
+
+namespace Igorski {
+
+#if defined( REGRADER_PROFILING )
+
+/* constructor */
+
+Profiler::Profiler()
+{
+    _lap = 0;
+    _sequence.store( 0 );
+    _resetRequested.store( false );
+
+    for ( int i = 0; i < STAGE_COUNT; ++i ) {
+        _blockNs[ i ] = 0;
+        _totals[ i ]  = { 0, 0, 0, 0 };
+
+        _published[ i ].blocks.store( 0 );
+        _published[ i ].frames.store( 0 );
+        _published[ i ].totalNs.store( 0 );
+        _published[ i ].maxNs.store( 0 );
+    }
+}
+
+/* public methods */
+
+void Profiler::endBlock( int frames )
+{
+    bool clear = _resetRequested.exchange( false, std::memory_order_acquire );
+
+    for ( int i = 0; i < STAGE_COUNT; ++i ) {
+        Statistics& totals = _totals[ i ];
+
+        if ( clear )
+            totals = { 0, 0, 0, 0 };
+
+        totals.blocks  += 1;
+        totals.frames  += ( uint64_t ) frames;
+        totals.totalNs += _blockNs[ i ];
+        totals.maxNs    = std::max( totals.maxNs, _blockNs[ i ]);
+    }
+
+    // the sequence is odd while the statistics are being written
+
+    uint32_t sequence = _sequence.load( std::memory_order_relaxed );
+    _sequence.store( sequence + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_release );
+
+    for ( int i = 0; i < STAGE_COUNT; ++i ) {
+        _published[ i ].blocks.store ( _totals[ i ].blocks,  std::memory_order_relaxed );
+        _published[ i ].frames.store ( _totals[ i ].frames,  std::memory_order_relaxed );
+        _published[ i ].totalNs.store( _totals[ i ].totalNs, std::memory_order_relaxed );
+        _published[ i ].maxNs.store  ( _totals[ i ].maxNs,   std::memory_order_relaxed );
+    }
+    _sequence.store( sequence + 2, std::memory_order_release );
+}
+
+void Profiler::getStatistics( Statistics* statistics )
+{
+    uint32_t sequence;
+
+    // retry for as long as the audio thread published a block during the read
+
+    do {
+        sequence = _sequence.load( std::memory_order_acquire );
+
+        for ( int i = 0; i < STAGE_COUNT; ++i ) {
+            statistics[ i ].blocks  = _published[ i ].blocks.load ( std::memory_order_relaxed );
+            statistics[ i ].frames  = _published[ i ].frames.load ( std::memory_order_relaxed );
+            statistics[ i ].totalNs = _published[ i ].totalNs.load( std::memory_order_relaxed );
+            statistics[ i ].maxNs   = _published[ i ].maxNs.load  ( std::memory_order_relaxed );
+        }
+        std::atomic_thread_fence( std::memory_order_acquire );
+    }
+    while (( sequence & 1 ) != 0 || sequence != _sequence.load( std::memory_order_relaxed ));
+}
+
+void Profiler::reset()
+{
+    _resetRequested.store( true, std::memory_order_release );
+}
+
+#endif
+
+const char* Profiler::getStageName( Stage stage )
+{
+    switch ( stage ) {
+        case PRE_CHAIN:  return "pre chain";
+        case DELAY:      return "delay";
+        case POST_CHAIN: return "post chain";
+        case MIX:        return "mix";
+        case LIMITER:    return "limiter";
+        default:         return "";
+    }
+}
+
+}
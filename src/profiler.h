@@ -0,0 +1,154 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __PROFILER_H_INCLUDED__
+#define __PROFILER_H_INCLUDED__
+
+#include "global.h"
+
+#if defined( REGRADER_PROFILING )
+#include <atomic>
+#include <chrono>
+#endif
+
+/**
+ * Profiler records the time spent in each stage of RegraderProcess::process(), per block.
+ *
+ * The instrumentation is only compiled in when REGRADER_PROFILING is defined (see the
+ * REGRADER_ENABLE_PROFILING option in CMakeLists.txt), otherwise all methods are empty
+ * and inline, as such the instrumented code compiles to the same as the uninstrumented.
+ *
+ * The audio thread is the single writer. It accumulates the time of each stage for the
+ * current block and publishes the totals once the block completes, through a sequence lock:
+ * readers (e.g. the controller, a test harness or CLI) retry when a block was published
+ * during their read, as such the audio thread never waits on (or is blocked by) a reader.
+ */
+namespace Igorski {
+class Profiler
+{
+    public:
+        enum Stage {
+            PRE_CHAIN = 0, // deinterleaving of the input and the effects before the delay
+            DELAY,         // the delay line and feedback
+            POST_CHAIN,    // the effects after the delay
+            MIX,           // mixing the dry and wet signals into the output
+            LIMITER,
+            STAGE_COUNT
+        };
+
+        struct Statistics {
+            uint64_t blocks;  // amount of profiled blocks
+            uint64_t frames;  // amount of frames within these blocks
+            uint64_t totalNs; // the total time spent in the stage
+            uint64_t maxNs;   // the most time spent in the stage within a single block
+        };
+
+        static const char* getStageName( Stage stage );
+
+#if defined( REGRADER_PROFILING )
+
+        Profiler();
+
+        static const bool ENABLED = true;
+
+        // invoked by the audio thread, prior to processing a block
+
+        inline void beginBlock()
+        {
+            for ( int i = 0; i < STAGE_COUNT; ++i )
+                _blockNs[ i ] = 0;
+
+            _lap = now();
+        }
+
+        // invoked by the audio thread when completing given stage, the time since the previous
+        // mark (or start of the block) is attributed to it. A stage can be marked multiple times
+        // within a block (e.g. once for each tile)
+
+        inline void mark( Stage stage )
+        {
+            uint64_t time = now();
+            _blockNs[ stage ] += time - _lap;
+            _lap = time;
+        }
+
+        // invoked by the audio thread after processing a block of given amount of frames
+        // publishes the statistics of the block
+
+        void endBlock( int frames );
+
+        // retrieve a consistent snapshot of the statistics of all stages (in order of the Stage enum)
+        // this can be invoked from any thread
+
+        void getStatistics( Statistics* statistics );
+
+        // request the statistics to be reset (applied by the audio thread on the next block)
+
+        void reset();
+
+    private:
+        static inline uint64_t now()
+        {
+            return ( uint64_t ) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()
+            ).count();
+        }
+
+        // audio thread state
+
+        uint64_t _lap;
+        uint64_t _blockNs[ STAGE_COUNT ];
+        Statistics _totals[ STAGE_COUNT ];
+
+        // published state
+
+        struct PublishedStatistics {
+            std::atomic<uint64_t> blocks;
+            std::atomic<uint64_t> frames;
+            std::atomic<uint64_t> totalNs;
+            std::atomic<uint64_t> maxNs;
+        };
+
+        std::atomic<uint32_t> _sequence; // odd while publishing
+        std::atomic<bool> _resetRequested;
+        PublishedStatistics _published[ STAGE_COUNT ];
+
+#else
+
+        static const bool ENABLED = false;
+
+        inline void beginBlock() {}
+        inline void mark( Stage ) {}
+        inline void endBlock( int ) {}
+        inline void reset() {}
+
+        inline void getStatistics( Statistics* statistics )
+        {
+            for ( int i = 0; i < STAGE_COUNT; ++i )
+                statistics[ i ] = { 0, 0, 0, 0 };
+        }
+
+#endif
+};
+}
+
+#endif
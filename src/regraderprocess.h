@@ -24,16 +24,42 @@
 #define __REGRADERPROCESS__H_INCLUDED__
 
 #include "global.h"
+#include "calc.h"
 #include "audiobuffer.h"
 #include "bitcrusher.h"
 #include "decimator.h"
+#include "delayline.h"
 #include "filter.h"
 #include "flanger.h"
+#include "kernels.h"
 #include "limiter.h"
+#include "oversampler.h"
+#include "profiler.h"
+#include "smoothedvalue.h"
 
-using namespace Steinberg;
+#include <array>
+#include <math.h>
+#include <string.h>
+#include <utility>
 
 namespace Igorski {
+
+// the settings that trade processing precision for CPU load. The plugin applies a cheap
+// profile when performing in realtime and a high quality profile when rendering offline
+// (e.g. when bouncing) where processing is not bound by the audio deadline
+
+struct QualityProfile {
+    Interpolation::Type delayInterpolation; // kernel used to read the delay at fractional delay times
+    int oversamplingFactor;                 // minimum oversampling factor of the nonlinear stages
+    int filterControlInterval;              // frames between updates of the modulated filter coefficients
+};
+
+namespace QualityProfiles {
+    static const QualityProfile REALTIME = { Interpolation::LINEAR,   1, 16 };
+    static const QualityProfile OFFLINE  = { Interpolation::LAGRANGE, 4, 1  };
+}
+
+template <typename SampleType>
 class RegraderProcess {
 
     // max delay time in milliseconds
@@ -42,18 +68,75 @@ class RegraderProcess {
 
     const float MAX_DELAY_TIME_MS = 5000.f;
 
+    // the amount of samples streamed through the full chain at a time when processing fused
+    // the intermediate buffers for a tile of this size comfortably fit the L1 cache
+
+    const int FUSED_TILE_SIZE = 256;
+
+    // delay times (in samples) below this value are processed frame by frame as
+    // the runs for block processing would be too short to outweigh their overhead
+
+    const int MIN_BLOCK_DELAY_TIME = 32;
+
     public:
-        RegraderProcess( int amountOfChannels );
+        RegraderProcess( int amountOfChannels, int maxBufferSize );
         ~RegraderProcess();
 
+        // (re)create all channel specific state (e.g. delay memory) for given amount of channels
+        // this allocates and should be invoked when setting up processing, not during
+
+        void setAmountOfChannels( int amountOfChannels );
+        int getAmountOfChannels();
+
+        // (re)create the intermediate buffers to hold given amount of samples per channel
+        // this allocates and should be invoked when setting up processing, not during. Buffers
+        // larger than the maximum buffer size are processed in multiple passes of this size
+
+        void setMaxBufferSize( int maxBufferSize );
+        int getMaxBufferSize();
+
+        // recalculate all sample rate dependent state for the current VST::SAMPLE_RATE
+        // the delay memory is sized to hold MAX_DELAY_TIME_MS at the current rate, it is
+        // recreated (allocating) only when the rate changes and should be invoked when
+        // setting up processing, not during
+
+        void updateSampleRate();
+
         // apply effect to incoming sampleBuffer contents
+        // when idle (see isIdle()) and the input is silent, the output is silenced without processing
 
-        template <typename SampleType>
         void process( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels,
-            int bufferSize, uint32 sampleFramesSize
+            int bufferSize, uint32_t sampleFramesSize
         );
 
-        // set delay time (in milliseconds)
+        // whether the processor is idle: its last output was silent and the tails of the delay (and
+        // the flanger, when active) have decayed. While idle, silent input results in silent output
+
+        bool isIdle();
+
+        // the amount of samples the effect chain continues to output after its input falls silent
+        // for the current delay and flanger settings (can be infinite when the feedback does not attenuate)
+
+        double getTailSamples();
+
+        // the factor (1, 2, 4 or 8) by which the signal is oversampled around the nonlinear
+        // stages (the BitCrusher and Decimator) to reduce their aliasing. Does not allocate
+        // the applied factor is raised to the minimum factor of the quality profile, if higher
+
+        void setOversamplingFactor( int factor );
+        int getOversamplingFactor();
+
+        // apply the interpolation, oversampling and filter modulation settings of given profile
+        // this does not allocate, but can change the latency (see getLatency())
+
+        void setQualityProfile( const QualityProfile& profile );
+
+        // the amount of samples by which the output lags the input (e.g. due to oversampling)
+
+        int getLatency();
+
+        // set delay time (normalized 0 - 1 range of either MAX_DELAY_TIME_MS or a full measure
+        // when synced to the host)
 
         void setDelayTime( float value );
         void setDelayFeedback( float value );
@@ -62,14 +145,18 @@ class RegraderProcess {
         // synchronize the delays tempo with the host
         // tempo is in BPM, time signature provided as: timeSigNumerator / timeSigDenominator (e.g. 3/4)
 
-        void setTempo( double tempo, int32 timeSigNumerator, int32 timeSigDenominator );
+        void setTempo( double tempo, int32_t timeSigNumerator, int32_t timeSigDenominator );
 
-        BitCrusher* bitCrusher;
-        Decimator* decimator;
-        Filter* filter;
-        Flanger* flanger;
+        BitCrusher<SampleType>* bitCrusher;
+        Decimator<SampleType>* decimator;
+        Filter<SampleType>* filter;
+        Flanger<SampleType>* flanger;
         Limiter* limiter;
 
+        // the processing time of each stage (only recorded when compiled with REGRADER_PROFILING)
+
+        Profiler* profiler;
+
         // whether effects are applied onto the input delay signal or onto
         // the delayed signal itself (false = on input, true = on delay)
 
@@ -82,28 +169,154 @@ class RegraderProcess {
 
         bool syncDelayToHost;
 
+        // the kernel used to interpolate the delayed signal when the delay time
+        // is not an integer amount of samples (e.g. when synced to the host tempo)
+
+        Interpolation::Type delayInterpolation;
+
+        // whether to stream the input through the full effect chain in cache sized tiles
+        // (true) or to have each effect process the full buffer in turn (false)
+        // both produce identical output, the fused mode requires less memory bandwidth
+
+        bool fusedProcessing;
+
     private:
-        AudioBuffer* _delayBuffer;   // contains the delay memory
-        AudioBuffer* _preMixBuffer;  // buffer used for the pre-delay effect mixing
-        AudioBuffer* _postMixBuffer; // buffer used for the post-delay effect mixing
 
-        int* _delayIndices;
+        // the delay memory and the pre- and post mix buffers contain interleaved frames
+        // (e.g. L R L R for stereo) so all channels are processed in a single pass, sharing
+        // the modulation of the effects (which only has to be calculated once per frame)
+
+        DelayLine<SampleType>* _delayLine; // contains the delay memory
+        SampleType* _preMixBuffer;   // buffer used for the pre-delay effect mixing
+        SampleType* _postMixBuffer;  // buffer used for the post-delay effect mixing
+        AudioBuffer* _rampBuffer;    // contains the per-sample values of the smoothed delay parameters
 
-        int _delayTime; // delay time is represented internally in buffer samples
-        float _delayMix;
-        float _delayFeedback;
+        // the signal is oversampled around the nonlinear stages before (pre) and after (post) the delay
+        // as the oversampling introduces latency, the dry signal (and when only one of these positions is
+        // oversampled, the wet signal) is delayed for both to have the same constant latency
+
+        Oversampler<SampleType>* _preOversampler;
+        Oversampler<SampleType>* _postOversampler;
+        DelayLine<SampleType>* _dryDelayLine; // latency compensation for the dry signal
+        DelayLine<SampleType>* _wetDelayLine; // latency compensation for the wet signal
+        SampleType* _dryBuffer;               // buffer used for the (latency compensated) dry signal
+        int _latency;                         // in frames, 0 when not oversampling
+        int _oversamplingFactor;              // the factor requested by setOversamplingFactor()
+        int _minOversamplingFactor;           // the factor requested by the quality profile
+        int _silentInputFrames;               // amount of inaudible input frames since the last audible one
+
+        int _delayBufferSize;        // maximum delay time (in frames)
+        int _delaySilentFrames;      // amount of inaudible frames written into the delay memory since the last audible one
+        bool _silentOutput;          // whether the input and output of the last processed buffer were silent
+        int _maxBufferSize;          // size of the mix and ramp buffers (in frames)
+
+        float _delayTimeValue; // normalized delay time (see setDelayTime())
+        double _delayTime;     // delay time is represented internally in (fractional) buffer samples
+        SmoothedValue* _delayMix;
+        SmoothedValue* _delayFeedback;
         int _amountOfChannels;
 
         double _tempo;
-        int32 _timeSigNumerator;
-        int32 _timeSigDenominator;
+        int32_t _timeSigNumerator;
+        int32_t _timeSigDenominator;
+
+        // the routing of the signal through the effect chain is described by a combination of these
+        // flags. Each combination is processed by its own specialization of processTile(), in which the
+        // effects that are inactive or in the other position are not present (e.g. there is no branching)
+
+        enum RouteFlags {
+            ROUTE_BIT_CRUSHER      = 1 << 0, // bit crusher is active
+            ROUTE_BIT_CRUSHER_POST = 1 << 1, // bit crusher is applied post mix (pre mix otherwise)
+            ROUTE_DECIMATOR        = 1 << 2,
+            ROUTE_DECIMATOR_POST   = 1 << 3,
+            ROUTE_FILTER_POST      = 1 << 4, // the filter is always active
+            ROUTE_FLANGER          = 1 << 5,
+            ROUTE_FLANGER_POST     = 1 << 6,
+            ROUTE_COUNT            = 1 << 7
+        };
+
+        // the specializations of processTile() indexed by route, selected once per process() call
+
+        typedef void ( RegraderProcess::*TileProcessor )( SampleType** inBuffer, SampleType** outBuffer, int numChannels,
+                                                          int offset, int tileSize, float* feedbackRamp, float* mixRamp );
+
+        std::array<TileProcessor, ROUTE_COUNT> _tileProcessors;
+
+        // (re)creates the pre- and post mix (and ramp) buffers for the current
+        // amount of channels and maximum buffer size
+
+        void createMixBuffers();
+
+        // (re)creates the delay memory for the current amount of channels and maximum delay time
+
+        void createDelayBuffer();
+
+        // calculates the delay time in samples for the current delay time value, tempo and sample rate
+
+        void updateDelayTime();
+
+        // ensures the delay time does not exceed the delay memory
+
+        void clampDelayTime();
+
+        // oversample the nonlinear stages by given factor and update the latency accordingly
+
+        void applyOversamplingFactor( int factor );
+
+        // keep track of the audibility of the delay memory after writing given amount
+        // of frames into it (where peak is the highest absolute sample value of these frames)
+
+        inline void updateDelayAudibility( SampleType peak, int amountOfFrames )
+        {
+            if ( peak < VST::SILENCE_THRESHOLD )
+                _delaySilentFrames = std::min( _delaySilentFrames + amountOfFrames, _delayLine->getCapacity() );
+            else
+                _delaySilentFrames = 0;
+        }
+
+        // apply the active nonlinear stages of given route in given position (pre- or post mix) onto given buffer
+        // at the oversampled rate (in tiles of FUSED_TILE_SIZE, for which the oversampler was sized)
+
+        template <int route, bool postMix>
+        void processOversampled( Oversampler<SampleType>* oversampler, SampleType* buffer, int numChannels, int bufferSize );
+
+        // delay given buffer of interleaved frames by given amount of frames using given delay line
+
+        void delayFrames( DelayLine<SampleType>* delayLine, SampleType* buffer, int numChannels, int bufferSize, int delay );
+
+        // whether the flanger is to be applied (e.g. has a positive rate or width)
+
+        bool isFlangerActive();
+
+        // the route for the current chain configuration and state of the effects
+
+        int getRoute();
+
+        // routes only differing in the position of an inactive flanger are processed identically, as such
+        // these share a specialization. Note the position of the nonlinear stages remains relevant when these
+        // are inactive, as it determines which positions are oversampled (and thus the timing of the signal)
+
+        static constexpr int getCanonicalRoute( int route )
+        {
+            return ( route & ROUTE_FLANGER ) ? route : route & ~ROUTE_FLANGER_POST;
+        }
+
+        template <size_t... routes>
+        static std::array<TileProcessor, ROUTE_COUNT> createTileProcessors( std::index_sequence<routes...> )
+        {
+            return {{ &RegraderProcess::template processTile<getCanonicalRoute( routes )>... }};
+        }
+
+        // whether given buffers contain no audible signal
+
+        static bool isSilent( SampleType** buffers, int numChannels, int bufferSize );
 
-        // ensures the pre- and post mix buffers match the appropriate amount of channels
-        // and buffer size. this also clones the contents of given in buffer into the pre-mix buffer
-        // the buffers are pooled so this can be called upon each process cycle without allocation overhead
+        // apply the effect chain for given route onto all channels for a range of samples starting at given offset
+        // (the full buffer when processing staged or a tile when processing fused)
 
-        template <typename SampleType>
-        void prepareMixBuffers( SampleType** inBuffer, int numInChannels, int bufferSize );
+        template <int route>
+        void processTile( SampleType** inBuffer, SampleType** outBuffer, int numChannels, int offset, int tileSize,
+                          float* feedbackRamp, float* mixRamp );
 
         // syncs current delay time to musically pleasing intervals synced to host tempo and time signature
 
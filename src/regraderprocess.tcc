@@ -22,164 +22,706 @@
  */
 namespace Igorski
 {
+
 template <typename SampleType>
-void RegraderProcess::process( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels,
-                               int bufferSize, uint32 sampleFramesSize ) {
+RegraderProcess<SampleType>::RegraderProcess( int amountOfChannels, int maxBufferSize ) {
+    _delayTimeValue = 0.f;
+    _delayTime      = 0.0;
+    _delayMix       = new SmoothedValue( .5f, 20.f, SmoothedValue::LINEAR );
+    _delayFeedback  = new SmoothedValue( .1f, 20.f, SmoothedValue::LINEAR );
+
+    _delayBufferSize  = Calc::millisecondsToBuffer( MAX_DELAY_TIME_MS );
+    _delayLine        = new DelayLine<SampleType>();
+    _delaySilentFrames = 0;
+    _silentOutput      = false;
+    _amountOfChannels = 0;
+
+    bitCrusher = new BitCrusher<SampleType>( 8, .5f, .5f );
+    decimator  = new Decimator<SampleType>( 32, 0.f );
+    filter     = new Filter<SampleType>( amountOfChannels );
+    flanger    = new Flanger<SampleType>( amountOfChannels );
+    limiter    = new Limiter( 10.f, 500.f, .6f );
+    profiler   = new Profiler();
+
+    bitCrusherPostMix = false;
+    decimatorPostMix  = false;
+    filterPostMix     = true;
+    flangerPostMix    = true;
+
+    // these will be synced to host, see vst.cpp. here we default to 120 BPM in 4/4 time
+    _tempo              = 120.0;
+    _timeSigNumerator   = 4;
+    _timeSigDenominator = 4;
+
+    syncDelayToHost     = true;
+    delayInterpolation  = Interpolation::HERMITE;
+    fusedProcessing     = true;
+
+    _preMixBuffer  = 0;
+    _postMixBuffer = 0;
+    _rampBuffer    = 0;
+    _maxBufferSize = std::max( 1, maxBufferSize );
+
+    // the oversamplers process in tiles, as such their size is not affected by the maximum buffer size
+
+    _preOversampler    = new Oversampler<SampleType>( amountOfChannels, FUSED_TILE_SIZE );
+    _postOversampler   = new Oversampler<SampleType>( amountOfChannels, FUSED_TILE_SIZE );
+    _dryDelayLine      = new DelayLine<SampleType>();
+    _wetDelayLine      = new DelayLine<SampleType>();
+    _dryBuffer         = 0;
+    _latency           = 0;
+    _silentInputFrames = 0;
+
+    _oversamplingFactor    = 1;
+    _minOversamplingFactor = 1;
+
+    _tileProcessors = createTileProcessors( std::make_index_sequence<ROUTE_COUNT>() );
+
+    setAmountOfChannels( amountOfChannels );
+}
 
-    // input and output buffers can be float or double as defined
-    // by the templates SampleType value. Internally we process
-    // audio as floats
+template <typename SampleType>
+RegraderProcess<SampleType>::~RegraderProcess() {
+    delete _delayLine;
+    delete[] _postMixBuffer;
+    delete[] _preMixBuffer;
+    delete[] _dryBuffer;
+    delete _rampBuffer;
+    delete _preOversampler;
+    delete _postOversampler;
+    delete _dryDelayLine;
+    delete _wetDelayLine;
+    delete _delayMix;
+    delete _delayFeedback;
+    delete bitCrusher;
+    delete decimator;
+    delete filter;
+    delete flanger;
+    delete limiter;
+    delete profiler;
+}
 
-    SampleType inSample;
-    float delaySample;
-    int i, readIndex, delayIndex, channelDelayBufferChannel;
+/* setters */
 
-    SampleType dryMix = 1.f - _delayMix;
-    int maxReadIndex  = std::min( _delayTime, _delayBuffer->bufferSize );
+template <typename SampleType>
+void RegraderProcess<SampleType>::setAmountOfChannels( int amountOfChannels )
+{
+    if ( _delayLine->getAmountOfChannels() == amountOfChannels )
+        return;
 
-    // prepare the mix buffers and clone the incoming buffer contents into the pre-mix buffer
+    _amountOfChannels = amountOfChannels;
 
-    prepareMixBuffers( inBuffer, numInChannels, bufferSize );
+    _preOversampler->setAmountOfChannels( amountOfChannels );
+    _postOversampler->setAmountOfChannels( amountOfChannels );
 
-    // only apply flange if the flanger has a positive rate or width
+    createDelayBuffer();
+    createMixBuffers();
 
-    bool hasFlanger = ( flanger->getRate() > 0.f || flanger->getWidth() > 0.f );
+    filter->setAmountOfChannels( amountOfChannels );
+    flanger->setAmountOfChannels( amountOfChannels );
+}
 
-    for ( int32 c = 0; c < numInChannels; ++c )
-    {
-        SampleType* channelInBuffer  = inBuffer[ c ];
-        SampleType* channelOutBuffer = outBuffer[ c ];
-        float* channelPreMixBuffer   = _preMixBuffer->getBufferForChannel( c );
-        float* channelDelayBuffer    = _delayBuffer->getBufferForChannel( c );
-        float* channelPostMixBuffer  = _postMixBuffer->getBufferForChannel( c );
+template <typename SampleType>
+int RegraderProcess<SampleType>::getAmountOfChannels()
+{
+    return _amountOfChannels;
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::setMaxBufferSize( int maxBufferSize )
+{
+    maxBufferSize = std::max( 1, maxBufferSize );
 
-        delayIndex = _delayIndices[ c ];
+    if ( _maxBufferSize == maxBufferSize )
+        return;
 
-        // when processing the first channel, store the current effects properties
-        // so each subsequent channel is processed using the same processor variables
+    _maxBufferSize = maxBufferSize;
 
-        if ( c == 0 ) {
-            decimator->store();
-            filter->store();
-            flanger->store();
-        }
+    createMixBuffers();
+}
 
-        // PRE MIX processing
+template <typename SampleType>
+int RegraderProcess<SampleType>::getMaxBufferSize()
+{
+    return _maxBufferSize;
+}
 
-        if ( !bitCrusherPostMix )
-            bitCrusher->process( channelPreMixBuffer, bufferSize );
+template <typename SampleType>
+void RegraderProcess<SampleType>::updateSampleRate()
+{
+    // the delay memory is only recreated when its size changes, as such the memory for a
+    // higher sample rate is only allocated once that rate is used, and released when it drops
 
-        if ( !decimatorPostMix )
-            decimator->process( channelPreMixBuffer, bufferSize );
+    int delayBufferSize = Calc::millisecondsToBuffer( MAX_DELAY_TIME_MS );
 
-        if ( !filterPostMix )
-            filter->process( channelPreMixBuffer, bufferSize, c );
+    if ( delayBufferSize != _delayBufferSize ) {
+        _delayBufferSize = delayBufferSize;
+        createDelayBuffer();
+    }
+    updateDelayTime();
 
-        if ( hasFlanger && !flangerPostMix )
-            flanger->process( channelPreMixBuffer, bufferSize, c );
+    filter->calculateParameters();
+    flanger->updateSampleRate();
+}
 
-        // DELAY processing applied onto the temp buffer
+template <typename SampleType>
+void RegraderProcess<SampleType>::setOversamplingFactor( int factor )
+{
+    _oversamplingFactor = factor;
 
-        for ( i = 0; i < bufferSize; ++i )
-        {
-            readIndex = delayIndex - _delayTime + 1;
+    applyOversamplingFactor( std::max( _oversamplingFactor, _minOversamplingFactor ));
+}
 
-            if ( readIndex < 0 ) {
-                readIndex += _delayTime;
-            }
+template <typename SampleType>
+int RegraderProcess<SampleType>::getOversamplingFactor()
+{
+    return _preOversampler->getFactor();
+}
 
-            // read the previously delayed samples from the buffer
-            // ( for feedback purposes ) and append the processed pre mix buffer sample to it
+template <typename SampleType>
+void RegraderProcess<SampleType>::setQualityProfile( const QualityProfile& profile )
+{
+    delayInterpolation = profile.delayInterpolation;
+    filter->setControlInterval( profile.filterControlInterval );
 
-            delaySample = channelDelayBuffer[ readIndex ];
-            channelDelayBuffer[ delayIndex ] = channelPreMixBuffer[ i ] + delaySample * _delayFeedback;
+    _minOversamplingFactor = profile.oversamplingFactor;
 
-            if ( ++delayIndex >= maxReadIndex ) {
-                delayIndex = 0;
-            }
+    applyOversamplingFactor( std::max( _oversamplingFactor, _minOversamplingFactor ));
+}
 
-            // write the delay sample into the post mix buffer
-            channelPostMixBuffer[ i ] = delaySample;
-        }
+template <typename SampleType>
+int RegraderProcess<SampleType>::getLatency()
+{
+    return _latency;
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::setDelayTime( float value )
+{
+    _delayTimeValue = Calc::cap( value );
+
+    updateDelayTime();
+}
 
-        // update last delay index for this channel
+template <typename SampleType>
+void RegraderProcess<SampleType>::setDelayMix( float value )
+{
+    _delayMix->setTarget( value );
+}
 
-        _delayIndices[ c ] = delayIndex;
+template <typename SampleType>
+void RegraderProcess<SampleType>::setDelayFeedback( float value )
+{
+    _delayFeedback->setTarget( value );
+}
 
-        // POST MIX processing
-        // apply the post mix effect processing
+template <typename SampleType>
+void RegraderProcess<SampleType>::setTempo( double tempo, int32_t timeSigNumerator, int32_t timeSigDenominator )
+{
+    if ( _tempo == tempo && _timeSigNumerator == timeSigNumerator && _timeSigDenominator == timeSigDenominator )
+        return;
+
+    _timeSigNumerator   = timeSigNumerator;
+    _timeSigDenominator = timeSigDenominator;
+    _tempo              = tempo;
 
-        if ( decimatorPostMix )
-            decimator->process( channelPostMixBuffer, bufferSize );
+    // if delay is synced to host tempo, keep delay time
+    // relative to new tempo
+
+    if ( syncDelayToHost )
+        updateDelayTime();
+}
 
-        if ( bitCrusherPostMix )
-            bitCrusher->process( channelPostMixBuffer, bufferSize );
+/* protected methods */
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::applyOversamplingFactor( int factor )
+{
+    if ( _preOversampler->getFactor() == factor )
+        return;
 
-        if ( filterPostMix )
-            filter->process( channelPostMixBuffer, bufferSize, c );
+    _preOversampler->setFactor( factor );
+    _postOversampler->setFactor( factor );
 
-        if ( hasFlanger && flangerPostMix )
-            flanger->process( channelPostMixBuffer, bufferSize, c );
+    factor = _preOversampler->getFactor(); // as sanitized by the oversampler
 
-        // mix the input and processed post mix buffers into the output buffer
+    bitCrusher->setOversamplingFactor( factor );
+    decimator->setOversamplingFactor( factor );
 
-        for ( i = 0; i < bufferSize; ++i ) {
+    // the latency accounts for oversampling in both the pre- and post mix positions, regardless of
+    // the chain configuration, so it remains constant when effects are moved within the chain
 
-            // before writing to the out buffer we take a snapshot of the current in sample
-            // value as VST2 in Ableton Live supplies the same buffer for in and out!
-            inSample = channelInBuffer[ i ];
+    _latency = ( factor > 1 ) ? _preOversampler->getLatency() * 2 : 0;
 
-            // wet mix (e.g. the effected delay signal)
-            channelOutBuffer[ i ] = ( SampleType ) channelPostMixBuffer[ i ] * _delayMix;
+    // the oversamplers have cleared their history, as such the compensated signals start from silence
 
-            // dry mix (e.g. mix in the input signal)
-            channelOutBuffer[ i ] += ( inSample * dryMix );
+    _dryDelayLine->clear();
+    _wetDelayLine->clear();
+    _silentInputFrames = _latency;
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::createDelayBuffer()
+{
+    _delayLine->resize( _amountOfChannels, _delayBufferSize );
+
+    // the delay memory is cleared upon creation
+
+    _delaySilentFrames = _delayLine->getCapacity();
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::updateDelayTime()
+{
+    // maximum delay time is specified in MAX_DELAY_TIME_MS when using freeform scaling
+    // when the delay is synced to the host, the maximum time is a single measure
+    // at the current tempo and time signature
+
+    // the delay time is calculated at double precision and is not truncated to whole samples
+    // so a synced delay remains exactly on the hosts grid, regardless of tempo and sample rate
+
+    double delayMaxInSeconds = ( syncDelayToHost ) ? ( 60.0 / _tempo ) * _timeSigDenominator
+        : MAX_DELAY_TIME_MS / 1000.0;
+
+    _delayTime = Calc::secondsToSamples( _delayTimeValue * delayMaxInSeconds );
+
+    if ( syncDelayToHost )
+        syncDelayTime();
+
+    clampDelayTime();
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::clampDelayTime()
+{
+    // a synced delay time (e.g. a full measure at a slow tempo) can exceed the delay memory
+
+    _delayTime = std::max( 0.0, std::min( _delayTime, ( double ) _delayBufferSize ));
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::createMixBuffers()
+{
+    delete[] _preMixBuffer;
+    delete[] _postMixBuffer;
+    delete[] _dryBuffer;
+    delete _rampBuffer;
+
+    _preMixBuffer  = new SampleType[ _maxBufferSize * _amountOfChannels ];
+    _postMixBuffer = new SampleType[ _maxBufferSize * _amountOfChannels ];
+    _dryBuffer     = new SampleType[ _maxBufferSize * _amountOfChannels ];
+
+    // the latency compensating delay lines are written prior to being read, as such
+    // they must hold the maximum latency in addition to the maximum buffer size
+
+    int maxLatency = _preOversampler->getLatency( Oversampler<SampleType>::MAX_FACTOR ) * 2;
+
+    _dryDelayLine->resize( _amountOfChannels, maxLatency + _maxBufferSize );
+    _wetDelayLine->resize( _amountOfChannels, maxLatency + _maxBufferSize );
+
+    // the ramp buffer holds the smoothed delay feedback and delay mix values
+
+    _rampBuffer = new AudioBuffer( 2, _maxBufferSize );
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::syncDelayTime()
+{
+    // duration of a full measure in samples
+
+    double fullMeasureSamples = Calc::secondsToSamples(( 60.0 / _tempo ) * _timeSigDenominator );
+
+    // we allow syncing to up to 32nd note resolution
+
+    double subdivisionSamples = fullMeasureSamples / 32;
+
+    _delayTime = round( _delayTime / subdivisionSamples ) * subdivisionSamples;
+}
+
+template <typename SampleType>
+void RegraderProcess<SampleType>::process( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels,
+                                           int bufferSize, uint32_t sampleFramesSize ) {
+
+    // input and output buffers can be float or double as defined
+    // by the templates SampleType value. The audio is processed
+    // internally at the same precision
+
+    float* feedbackRamp = _rampBuffer->getBufferForChannel( 0 );
+    float* mixRamp      = _rampBuffer->getBufferForChannel( 1 );
+
+    // the route is determined once, the effects are not reconfigured while processing
+
+    TileProcessor processTile = _tileProcessors[ getRoute() ];
+
+    // all channels are processed simultaneously as interleaved frames, we can
+    // only process as many channels as the processor state was created for
+
+    int numChannels = std::min( numInChannels, _amountOfChannels );
+
+    // determine whether the input is silent before processing (as the input
+    // and output buffers can be the same), when idle there is nothing to process
+
+    bool isSilentInput = isSilent( inBuffer, numChannels, bufferSize );
+
+    // keep track of the audibility of the input within reach of the latency compensation
+
+    _silentInputFrames = isSilentInput ? std::min( _silentInputFrames + bufferSize, _latency ) : 0;
+
+    if ( isSilentInput && isIdle() ) {
+        for ( int c = 0; c < numOutChannels; ++c ) {
+            memset( outBuffer[ c ], 0, bufferSize * sizeof( SampleType ));
         }
+        return;
+    }
+
+    profiler->beginBlock();
+
+    // when processing fused, the input is streamed through the full chain in tiles small
+    // enough for the intermediate buffers to remain in the L1 cache, otherwise the full buffer
+    // is processed by each stage in turn. As the effects process the frames of each tile in
+    // order, the output of both modes is identical
+
+    // the mix buffers are allocated when setting up processing, a buffer exceeding their size
+    // is processed in chunks of the maximum buffer size (e.g. nothing is allocated here)
+
+    for ( int chunkOffset = 0; chunkOffset < bufferSize; chunkOffset += _maxBufferSize )
+    {
+        int chunkSize = std::min( _maxBufferSize, bufferSize - chunkOffset );
+        int tileSize  = fusedProcessing ? std::min( chunkSize, FUSED_TILE_SIZE ) : chunkSize;
 
-        // prepare effects for the next channel
+        // render the (smoothed) delay parameters for this chunk, these are shared by all channels
 
-        if ( c < ( numInChannels - 1 )) {
-            decimator->restore();
-            filter->restore();
-            flanger->restore();
+        _delayFeedback->render( feedbackRamp, chunkSize );
+        _delayMix->render( mixRamp, chunkSize );
+
+        for ( int offset = 0; offset < chunkSize; offset += tileSize ) {
+            ( this->*processTile )(
+                inBuffer, outBuffer, numChannels, chunkOffset + offset, std::min( tileSize, chunkSize - offset ),
+                feedbackRamp + offset, mixRamp + offset
+            );
         }
     }
 
     // limit the output signal as it can get quite hot
     limiter->process<SampleType>( outBuffer, bufferSize, numOutChannels );
+
+    profiler->mark( Profiler::LIMITER );
+    profiler->endBlock( bufferSize );
+
+    _silentOutput = isSilentInput && isSilent( outBuffer, numOutChannels, bufferSize );
+}
+
+template <typename SampleType>
+bool RegraderProcess<SampleType>::isIdle()
+{
+    if ( !_silentOutput )
+        return false;
+
+    // all frames within reach of the delay (including its interpolation taps and the frames read during
+    // the latency period) must be inaudible (note the delay time could have increased after the delay
+    // memory was last processed)
+
+    if ( _delaySilentFrames < std::min(( int ) _delayTime + 3 + _latency, _delayLine->getCapacity()))
+        return false;
+
+    // as is all input that has yet to pass the latency compensation
+
+    if ( _silentInputFrames < _latency )
+        return false;
+
+    return !isFlangerActive() || flanger->isSilent();
+}
+
+template <typename SampleType>
+double RegraderProcess<SampleType>::getTailSamples()
+{
+    // the delay is repeated for each time the signal is fed back
+
+    double feedback    = std::max( _delayFeedback->getValue(), _delayFeedback->getTarget() );
+    double tailSamples = ( Calc::feedbackRepeats( feedback ) + 1.0 ) * std::max( 1.0, _delayTime );
+
+    if ( isFlangerActive() )
+        tailSamples += flanger->getTailSamples();
+
+    return tailSamples + _latency;
 }
 
 template <typename SampleType>
-void RegraderProcess::prepareMixBuffers( SampleType** inBuffer, int numInChannels, int bufferSize )
+template <int route, bool postMix>
+void RegraderProcess<SampleType>::processOversampled( Oversampler<SampleType>* oversampler, SampleType* buffer, int numChannels,
+                                                      int bufferSize )
 {
-    // if the pre mix buffer wasn't created yet or the buffer size has changed
-    // delete existing buffer and create new one to match properties
+    int factor = oversampler->getFactor();
+
+    for ( int offset = 0; offset < bufferSize; offset += FUSED_TILE_SIZE ) {
+        int tileSize = std::min( FUSED_TILE_SIZE, bufferSize - offset );
+        SampleType* tileBuffer = buffer + offset * numChannels;
+
+        SampleType* oversampledBuffer = oversampler->upsample( tileBuffer, numChannels, tileSize );
+        int oversampledSize = tileSize * factor;
+
+        // the stages are applied in the same order as when not oversampling (see processTile())
+
+        constexpr bool crush    = ( route & ROUTE_BIT_CRUSHER ) && postMix == (( route & ROUTE_BIT_CRUSHER_POST ) != 0 );
+        constexpr bool decimate = ( route & ROUTE_DECIMATOR )   && postMix == (( route & ROUTE_DECIMATOR_POST )   != 0 );
 
-    if ( _preMixBuffer == 0 || _preMixBuffer->bufferSize != bufferSize ) {
-        delete _preMixBuffer;
-        _preMixBuffer = new AudioBuffer( numInChannels, bufferSize );
+        if constexpr ( crush && !postMix )
+            bitCrusher->process( oversampledBuffer, numChannels, oversampledSize );
+
+        if constexpr ( decimate )
+            decimator->process( oversampledBuffer, numChannels, oversampledSize );
+
+        if constexpr ( crush && postMix )
+            bitCrusher->process( oversampledBuffer, numChannels, oversampledSize );
+
+        oversampler->downsample( tileBuffer, numChannels, tileSize );
     }
+}
 
-    // clone the in buffer contents
-    // note the clone is always cast to float as it is
-    // used for internal processing (see RegraderProcess::process)
+template <typename SampleType>
+void RegraderProcess<SampleType>::delayFrames( DelayLine<SampleType>* delayLine, SampleType* buffer, int numChannels,
+                                               int bufferSize, int delay )
+{
+    // the frames are written first, as such they are read back at the delay plus the buffer size
 
-    for ( int c = 0; c < numInChannels; ++c ) {
-        SampleType* inChannelBuffer = ( SampleType* ) inBuffer[ c ];
-        float* outChannelBuffer     = ( float* ) _preMixBuffer->getBufferForChannel( c );
+    delayLine->write( buffer, numChannels, bufferSize );
+    delayLine->read( delay + bufferSize, buffer, numChannels, bufferSize );
+}
+
+template <typename SampleType>
+bool RegraderProcess<SampleType>::isFlangerActive()
+{
+    // only apply flange if the flanger has a positive rate or width
+
+    return flanger->getRate() > 0.f || flanger->getWidth() > 0.f;
+}
+
+template <typename SampleType>
+int RegraderProcess<SampleType>::getRoute()
+{
+    int route = 0;
+
+    if ( bitCrusher->isActive() ) route |= ROUTE_BIT_CRUSHER;
+    if ( bitCrusherPostMix )      route |= ROUTE_BIT_CRUSHER_POST;
+    if ( decimator->isActive() )  route |= ROUTE_DECIMATOR;
+    if ( decimatorPostMix )       route |= ROUTE_DECIMATOR_POST;
+    if ( filterPostMix )          route |= ROUTE_FILTER_POST;
+    if ( isFlangerActive() )      route |= ROUTE_FLANGER;
+    if ( flangerPostMix )         route |= ROUTE_FLANGER_POST;
+
+    return getCanonicalRoute( route );
+}
+
+template <typename SampleType>
+bool RegraderProcess<SampleType>::isSilent( SampleType** buffers, int numChannels, int bufferSize )
+{
+    for ( int c = 0; c < numChannels; ++c ) {
+        SampleType* buffer = buffers[ c ];
+        SampleType peak    = 0;
 
         for ( int i = 0; i < bufferSize; ++i ) {
-            outChannelBuffer[ i ] = ( float ) inChannelBuffer[ i ];
+            peak = std::max( peak, ( SampleType ) fabs( buffer[ i ]));
+        }
+
+        if ( peak >= VST::SILENCE_THRESHOLD )
+            return false;
+    }
+    return true;
+}
+
+template <typename SampleType>
+template <int route>
+void RegraderProcess<SampleType>::processTile( SampleType** inBuffer, SampleType** outBuffer, int numChannels, int offset, int tileSize,
+                                               float* feedbackRamp, float* mixRamp )
+{
+    // the effects applied in each position of the chain (an inactive effect is in neither position)
+
+    constexpr bool preCrush     = ( route & ROUTE_BIT_CRUSHER ) && !( route & ROUTE_BIT_CRUSHER_POST );
+    constexpr bool preDecimate  = ( route & ROUTE_DECIMATOR )   && !( route & ROUTE_DECIMATOR_POST );
+    constexpr bool preFilter    = !( route & ROUTE_FILTER_POST );
+    constexpr bool preFlange    = ( route & ROUTE_FLANGER )     && !( route & ROUTE_FLANGER_POST );
+    constexpr bool postCrush    = ( route & ROUTE_BIT_CRUSHER ) &&  ( route & ROUTE_BIT_CRUSHER_POST );
+    constexpr bool postDecimate = ( route & ROUTE_DECIMATOR )   &&  ( route & ROUTE_DECIMATOR_POST );
+    constexpr bool postFilter   = !preFilter;
+    constexpr bool postFlange   = ( route & ROUTE_FLANGER )     &&  ( route & ROUTE_FLANGER_POST );
+
+    const Kernels::Table<SampleType>& kernels = Kernels::get<SampleType>();
+    int i, c;
+
+    // the intermediate buffers are always written from their start, when processing
+    // in tiles the same (cache resident) region is thus reused for each tile
+
+    SampleType* preMixBuffer  = _preMixBuffer;
+    SampleType* postMixBuffer = _postMixBuffer;
+
+    // clone the in buffer contents into the interleaved pre mix buffer
+
+    for ( c = 0; c < numChannels; ++c ) {
+        SampleType* channelInBuffer = inBuffer[ c ] + offset;
+
+        for ( i = 0; i < tileSize; ++i ) {
+            preMixBuffer[ i * numChannels + c ] = channelInBuffer[ i ];
         }
     }
 
-    // if the post mix buffer wasn't created yet or the buffer size has changed
-    // delete existing buffer and create new one to match properties
+    // when oversampling, the input is delayed by the latency so the dry signal aligns with the wet signal
 
-    if ( _postMixBuffer == 0 || _postMixBuffer->bufferSize != bufferSize ) {
-        delete _postMixBuffer;
-        _postMixBuffer = new AudioBuffer( numInChannels, bufferSize );
+    if ( _latency > 0 ) {
+        memcpy( _dryBuffer, preMixBuffer, tileSize * numChannels * sizeof( SampleType ));
+        delayFrames( _dryDelayLine, _dryBuffer, numChannels, tileSize, _latency );
     }
+
+    // inactive effects keep their modulation in time (as it continues once they become active)
+
+    if constexpr ( !( route & ROUTE_BIT_CRUSHER ))
+        bitCrusher->skip( tileSize );
+
+    if constexpr ( !( route & ROUTE_DECIMATOR ))
+        decimator->skip( tileSize );
+
+    // the positions the nonlinear stages are assigned to (whether active or not) are oversampled
+
+    constexpr bool preNonlinear  = !( route & ROUTE_BIT_CRUSHER_POST ) || !( route & ROUTE_DECIMATOR_POST );
+    constexpr bool postNonlinear =  ( route & ROUTE_BIT_CRUSHER_POST ) ||  ( route & ROUTE_DECIMATOR_POST );
+
+    bool isOversampling = _preOversampler->getFactor() > 1;
+
+    // PRE MIX processing
+
+    if constexpr ( preNonlinear ) {
+        if ( isOversampling ) {
+            processOversampled<route, false>( _preOversampler, preMixBuffer, numChannels, tileSize );
+        }
+        else {
+            if constexpr ( preCrush )
+                bitCrusher->process( preMixBuffer, numChannels, tileSize );
+
+            if constexpr ( preDecimate )
+                decimator->process( preMixBuffer, numChannels, tileSize );
+        }
+    }
+
+    if constexpr ( preFilter )
+        filter->process( preMixBuffer, numChannels, tileSize );
+
+    if constexpr ( preFlange )
+        flanger->process( preMixBuffer, numChannels, tileSize );
+
+    profiler->mark( Profiler::PRE_CHAIN );
+
+    // DELAY processing applied onto the temp buffer
+    // the tile is processed in runs no longer than the delay time, so each run
+    // only reads frames from the delay line that were written prior to the run
+
+    double delayTime = std::max(( double ) DelayLine<SampleType>::getMinimumDelay( delayInterpolation ), _delayTime );
+    int maxRunLength = DelayLine<SampleType>::getMaxReadLength( delayTime, delayInterpolation );
+
+    if ( maxRunLength < MIN_BLOCK_DELAY_TIME )
+    {
+        for ( i = 0; i < tileSize; ++i )
+        {
+            // read the previously delayed frame from the delay line
+            // ( for feedback purposes ) and append the processed pre mix frame to it
+
+            SampleType* writeFrame   = _delayLine->getFrame( 0 );
+            SampleType* preMixFrame  = preMixBuffer  + i * numChannels;
+            SampleType* postMixFrame = postMixBuffer + i * numChannels;
+            SampleType feedback      = feedbackRamp[ i ];
+            SampleType peak          = 0;
+
+            _delayLine->readFrame( delayTime, delayInterpolation, postMixFrame, numChannels );
+
+            for ( c = 0; c < numChannels; ++c ) {
+                writeFrame[ c ] = preMixFrame[ c ] + postMixFrame[ c ] * feedback;
+                peak = std::max( peak, ( SampleType ) fabs( writeFrame[ c ]));
+            }
+
+            // flush the decaying feedback before it reaches the denormal range
+
+            if ( peak < ( SampleType ) VST::DENORMAL_THRESHOLD )
+                memset( writeFrame, 0, numChannels * sizeof( SampleType ));
+
+            _delayLine->advance( 1 );
+            updateDelayAudibility( peak, 1 );
+        }
+    }
+    else for ( int runOffset = 0; runOffset < tileSize; runOffset += maxRunLength )
+    {
+        int runLength = std::min( maxRunLength, tileSize - runOffset );
+
+        SampleType* preMixRun  = preMixBuffer  + runOffset * numChannels;
+        SampleType* postMixRun = postMixBuffer + runOffset * numChannels;
+        float* feedbackRun     = feedbackRamp  + runOffset;
+
+        // read the previously delayed frames into the post mix buffer
+
+        _delayLine->read( delayTime, delayInterpolation, postMixRun, numChannels, runLength );
+
+        // append the delayed frames ( for feedback purposes ) to the processed
+        // pre mix frames and write the result into the delay line
+
+        SampleType peak = kernels.applyFeedback( preMixRun, postMixRun, feedbackRun, numChannels, runLength );
+
+        // flush the decaying feedback before it reaches the denormal range
+        // (as the feedback attenuates all frames equally, this occurs for full runs)
+
+        if ( peak < ( SampleType ) VST::DENORMAL_THRESHOLD )
+            memset( preMixRun, 0, runLength * numChannels * sizeof( SampleType ));
+
+        _delayLine->write( preMixRun, numChannels, runLength );
+        updateDelayAudibility( peak, runLength );
+    }
+
+    profiler->mark( Profiler::DELAY );
+
+    // POST MIX processing
+    // apply the post mix effect processing
+
+    if constexpr ( postNonlinear ) {
+        if ( isOversampling ) {
+            processOversampled<route, true>( _postOversampler, postMixBuffer, numChannels, tileSize );
+        }
+        else {
+            if constexpr ( postDecimate )
+                decimator->process( postMixBuffer, numChannels, tileSize );
+
+            if constexpr ( postCrush )
+                bitCrusher->process( postMixBuffer, numChannels, tileSize );
+        }
+    }
+
+    // when only one of the positions is oversampled, the wet signal is delayed by
+    // the latency of the other to match the (constant) latency of the dry signal
+
+    if constexpr ( preNonlinear != postNonlinear ) {
+        if ( isOversampling )
+            delayFrames( _wetDelayLine, postMixBuffer, numChannels, tileSize, _latency / 2 );
+    }
+
+    if constexpr ( postFilter )
+        filter->process( postMixBuffer, numChannels, tileSize );
+
+    if constexpr ( postFlange )
+        flanger->process( postMixBuffer, numChannels, tileSize );
+
+    profiler->mark( Profiler::POST_CHAIN );
+
+    // mix the input and processed post mix buffers into the output buffer
+    // (when oversampling, the dry signal is read from the latency compensated interleaved buffer)
+
+    int dryStride = ( _latency > 0 ) ? numChannels : 1;
+
+    // note the kernel reads each dry sample before writing the output as VST2
+    // in Ableton Live supplies the same buffer for in and out!
+
+    for ( c = 0; c < numChannels; ++c ) {
+        SampleType* channelInBuffer  = ( _latency > 0 ) ? _dryBuffer + c : inBuffer[ c ] + offset;
+        SampleType* channelOutBuffer = outBuffer[ c ] + offset;
+
+        kernels.mixWetDry( channelOutBuffer, postMixBuffer + c, numChannels, channelInBuffer, dryStride, mixRamp, tileSize );
+    }
+
+    profiler->mark( Profiler::MIX );
 }
 
 }
@@ -0,0 +1,156 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "smoothedvalue.h"
+#include "calc.h"
+#include <cmath>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+SmoothedValue::SmoothedValue( float value, float rampTimeMs, RampType rampType )
+{
+    _rampType    = rampType;
+    _coefficient = 1.f;
+
+    setRampTime( rampTimeMs );
+    setValue( value );
+}
+
+SmoothedValue::~SmoothedValue()
+{
+    // nowt...
+}
+
+/* public methods */
+
+void SmoothedValue::setTarget( float value )
+{
+    if ( value == _target )
+        return;
+
+    _target = value;
+
+    int steps = std::max( 1, Calc::millisecondsToBuffer( _rampTimeMs ));
+
+    if ( steps <= 1 ) {
+        setValue( value );
+        return;
+    }
+
+    _stepsRemaining = steps;
+    _rampSteps      = steps;
+    _rampStart      = _value;
+    _step           = ( _target - _value ) / ( float ) steps;
+    _delta          = _target - _value;
+
+    // for exponential ramps the remaining distance decays to -60 dB over the ramp duration
+    // (at which point the value snaps to the target)
+    _coefficient = ( float ) pow( 0.001, 1.0 / ( double ) steps );
+}
+
+float SmoothedValue::getTarget()
+{
+    return _target;
+}
+
+void SmoothedValue::setValue( float value )
+{
+    _value          = value;
+    _target         = value;
+    _step           = 0.f;
+    _delta          = 0.f;
+    _rampStart      = value;
+    _rampSteps      = 0;
+    _stepsRemaining = 0;
+}
+
+float SmoothedValue::getValue()
+{
+    return _value;
+}
+
+void SmoothedValue::setRampTime( float rampTimeMs )
+{
+    _rampTimeMs = rampTimeMs;
+}
+
+void SmoothedValue::render( float* buffer, int bufferSize )
+{
+    int rampSize = std::min( bufferSize, _stepsRemaining );
+    int i = 0;
+
+    if ( rampSize > 0 )
+    {
+        if ( _rampType == LINEAR )
+        {
+            // calculated from the start of the ramp (rather than accumulated) so the iterations
+            // are independent of each other and the loop can be vectorized, next() does the same
+
+            float start = _rampStart;
+            float step  = _step;
+            int offset  = _rampSteps - _stepsRemaining + 1;
+
+            for ( i = 0; i < rampSize; ++i ) {
+                buffer[ i ] = start + step * ( float ) ( offset + i );
+            }
+        }
+        else {
+            float target      = _target;
+            float delta       = _delta;
+            float coefficient = _coefficient;
+
+            for ( i = 0; i < rampSize; ++i ) {
+                delta *= coefficient;
+                buffer[ i ] = target - delta;
+            }
+            _delta = delta;
+        }
+        _stepsRemaining -= rampSize;
+
+        if ( _stepsRemaining == 0 )
+            buffer[ rampSize - 1 ] = _target;
+
+        _value = buffer[ rampSize - 1 ];
+    }
+
+    // remainder of the buffer is at the (constant) current value
+
+    float value = _value;
+
+    for ( ; i < bufferSize; ++i ) {
+        buffer[ i ] = value;
+    }
+}
+
+void SmoothedValue::skip( int numSamples )
+{
+    // advanced step by step so the outcome is identical to retrieving
+    // the values through next(), regardless of how the range is split up
+
+    for ( int i = std::min( numSamples, _stepsRemaining ); i > 0; --i ) {
+        next();
+    }
+}
+
+}
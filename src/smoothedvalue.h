@@ -0,0 +1,107 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __SMOOTHEDVALUE_H_INCLUDED__
+#define __SMOOTHEDVALUE_H_INCLUDED__
+
+/**
+ * SmoothedValue glides a parameter from its current value towards a new target
+ * over a fixed amount of time, preventing zipper noise and clicks when parameters
+ * are changed or automated. The ramp can be either linear or exponential.
+ *
+ * The ramp can be retrieved a single sample at a time using next() or for a
+ * full block at once using render(), the latter writes into a plain buffer
+ * the processing loops can read from (which the compiler can vectorize).
+ * When no ramp is in progress, both return the (constant) target value.
+ * Both yield identical values, regardless of how the ramp is split up.
+ */
+namespace Igorski {
+class SmoothedValue
+{
+    public:
+        enum RampType {
+            LINEAR = 0,
+            EXPONENTIAL
+        };
+
+        SmoothedValue( float value, float rampTimeMs, RampType rampType );
+        ~SmoothedValue();
+
+        // glide from the current value towards given value
+        void setTarget( float value );
+        float getTarget();
+
+        // immediately jump to given value, cancelling any ramp in progress
+        void setValue( float value );
+        float getValue();
+
+        void setRampTime( float rampTimeMs );
+
+        inline bool isRamping()
+        {
+            return _stepsRemaining > 0;
+        }
+
+        /**
+         * retrieve the value of the ramp for the next sample,
+         * this advances the ramp by a single step
+         */
+        inline float next()
+        {
+            if ( _stepsRemaining > 0 )
+            {
+                if ( --_stepsRemaining == 0 ) {
+                    _value = _target;
+                } else if ( _rampType == LINEAR ) {
+                    // calculated from the start of the ramp (rather than accumulated), see render()
+                    _value = _rampStart + _step * ( float ) ( _rampSteps - _stepsRemaining );
+                } else {
+                    _delta *= _coefficient;
+                    _value  = _target - _delta;
+                }
+            }
+            return _value;
+        }
+
+        // write the values of the ramp for the next bufferSize samples into given buffer
+        // and advance the ramp accordingly
+        void render( float* buffer, int bufferSize );
+
+        // advance the ramp by given amount of samples without retrieving its values
+        void skip( int numSamples );
+
+    private:
+        RampType _rampType;
+        float _rampTimeMs;
+
+        float _value;
+        float _target;
+        float _step;        // increment per sample for linear ramps
+        float _rampStart;   // value at the start of the linear ramp
+        int _rampSteps;     // total amount of steps of the ramp
+        float _delta;       // remaining distance to the target for exponential ramps
+        float _coefficient; // multiplier applied to the delta per sample for exponential ramps
+        int _stepsRemaining;
+};
+}
+
+#endif
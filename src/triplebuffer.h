@@ -0,0 +1,74 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __TRIPLEBUFFER_H_INCLUDED__
+#define __TRIPLEBUFFER_H_INCLUDED__
+
+#include <atomic>
+
+/**
+ * TripleBuffer hands off complete copies of a value of type T from a single
+ * writer thread to a single reader thread (e.g. from the UI thread to the audio
+ * thread, or vice versa) without locking. The writer fills the back buffer and publishes it, the reader
+ * picks up the most recently published buffer whenever it is ready to do so.
+ *
+ * Neither thread ever waits on the other and the reader never observes a
+ * partially written value, intermediate values published before the reader
+ * got to consume them are simply skipped.
+ */
+namespace Igorski {
+template <typename T>
+class TripleBuffer
+{
+    public:
+        TripleBuffer();
+        ~TripleBuffer();
+
+        // writer thread: retrieve the buffer to write into and publish it when done
+
+        T& getWriteBuffer();
+        void publish();
+
+        // reader thread: swap in the most recently published buffer, returns false
+        // when nothing was published since the last consumption. After consuming,
+        // the value is available through getReadBuffer()
+
+        bool consume();
+        const T& getReadBuffer() const;
+
+    private:
+        // the index of the buffer shared between writer and reader, the
+        // DIRTY_BIT flags that it contains a value not yet consumed by the reader
+
+        static const int DIRTY_BIT  = 4;
+        static const int INDEX_MASK = 3;
+
+        T _buffers[ 3 ];
+        std::atomic<int> _shared;
+        int _writeIndex;
+        int _readIndex;
+};
+}
+
+#include "triplebuffer.tcc"
+
+#endif
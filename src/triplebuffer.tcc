@@ -0,0 +1,74 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+template <typename T>
+TripleBuffer<T>::TripleBuffer()
+: _shared( 1 )
+, _writeIndex( 0 )
+, _readIndex( 2 )
+{
+
+}
+
+template <typename T>
+TripleBuffer<T>::~TripleBuffer()
+{
+    // nowt...
+}
+
+template <typename T>
+T& TripleBuffer<T>::getWriteBuffer()
+{
+    return _buffers[ _writeIndex ];
+}
+
+template <typename T>
+void TripleBuffer<T>::publish()
+{
+    // swap the written buffer with the shared one, the release ordering ensures the
+    // reader observes the full contents of the buffer once it acquires its index
+
+    int previous = _shared.exchange( _writeIndex | DIRTY_BIT, std::memory_order_acq_rel );
+    _writeIndex  = previous & INDEX_MASK;
+}
+
+template <typename T>
+bool TripleBuffer<T>::consume()
+{
+    if (( _shared.load( std::memory_order_relaxed ) & DIRTY_BIT ) == 0 )
+        return false;
+
+    int previous = _shared.exchange( _readIndex, std::memory_order_acq_rel );
+    _readIndex   = previous & INDEX_MASK;
+
+    return true;
+}
+
+template <typename T>
+const T& TripleBuffer<T>::getReadBuffer() const
+{
+    return _buffers[ _readIndex ];
+}
+
+}
@@ -24,6 +24,8 @@
 #include "controller.h"
 #include "uimessagecontroller.h"
 #include "../paramids.h"
+#include "../logger.h"
+#include "../profiler.h"
 
 #include "pluginterfaces/base/ibstream.h"
 #include "pluginterfaces/base/ustring.h"
@@ -36,6 +38,8 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <string.h>
+#include <algorithm>
 
 namespace Steinberg {
 namespace Vst {
@@ -224,6 +228,12 @@ tresult PLUGIN_API RegraderController::initialize( FUnknown* context )
         STR16( "Bypass" ), nullptr, 1, 0, ParameterInfo::kCanAutomate | ParameterInfo::kIsBypass, kBypassId
     );
 
+    // the oversampling factor affects the latency of the plugin, as such it cannot be automated
+
+    parameters.addParameter(
+        USTRING( "Oversampling" ), 0, 3, 0, ParameterInfo::kNoFlags, kOversamplingId, unitId
+    );
+
     // initialization
 
     String str( "REGRADER" );
@@ -336,6 +346,12 @@ tresult PLUGIN_API RegraderController::setComponentState( IBStream* state )
             setParamNormalized( kBypassId, savedBypass ? 1 : 0 );
         }
 
+        // may fail as this was added after the bypass
+        float savedOversampling = 0.f;
+        if ( streamer.readFloat( savedOversampling ) != false ) {
+            setParamNormalized( kOversamplingId, savedOversampling );
+        }
+
         setParamNormalized( kDelayTimeId,             savedDelayTime );
         setParamNormalized( kDelayHostSyncId,         savedDelayHostSync );
         setParamNormalized( kDelayFeedbackId,         savedDelayFeedback );
@@ -433,18 +449,72 @@ tresult RegraderController::receiveText( const char* text )
     // received from Component
     if ( text )
     {
-        fprintf( stderr, "[RegraderController] received: " );
-        fprintf( stderr, "%s", text );
-        fprintf( stderr, "\n" );
+        Igorski::Logger::log( "[RegraderController] received: %s", text );
     }
     return kResultOk;
 }
 
+//------------------------------------------------------------------------
+tresult PLUGIN_API RegraderController::notify( IMessage* message )
+{
+    if ( !message )
+        return kInvalidArgument;
+
+    // the profiling statistics of the processor (see Regrader::sendProfilerStatistics)
+
+    if ( !strcmp( message->getMessageID(), "ProfilerStatistics" ))
+    {
+        typedef Igorski::Profiler Profiler;
+
+        const void* data;
+        uint32 size;
+
+        if ( message->getAttributes()->getBinary( "statistics", data, size ) == kResultOk &&
+             size == sizeof( Profiler::Statistics ) * Profiler::STAGE_COUNT )
+        {
+            const Profiler::Statistics* statistics = ( const Profiler::Statistics* ) data;
+
+            for ( int i = 0; i < Profiler::STAGE_COUNT; ++i ) {
+                const Profiler::Statistics& stage = statistics[ i ];
+
+                double blocks = ( double ) std::max(( uint64 ) 1, stage.blocks );
+                double frames = ( double ) std::max(( uint64 ) 1, stage.frames );
+
+                Igorski::Logger::log( "[RegraderController] %-10s %10.2f us/block (max %.2f us) %8.2f ns/frame",
+                         Profiler::getStageName(( Profiler::Stage ) i ), stage.totalNs / blocks / 1000.0,
+                         stage.maxNs / 1000.0, stage.totalNs / frames );
+            }
+        }
+        return kResultOk;
+    }
+
+    // the latency of the processor changed without a parameter change (see Regrader::sendLatencyChanged)
+
+    if ( !strcmp( message->getMessageID(), "LatencyChanged" ))
+    {
+        if ( componentHandler != nullptr )
+            componentHandler->restartComponent( kLatencyChanged );
+
+        return kResultOk;
+    }
+    return EditControllerEx1::notify( message );
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API RegraderController::setParamNormalized( ParamID tag, ParamValue value )
 {
     // called from host to update our parameters state
+
+    bool isLatencyChange = tag == kOversamplingId && getParamNormalized( tag ) != value;
+
     tresult result = EditControllerEx1::setParamNormalized( tag, value );
+
+    // the oversampling factor determines the latency, request the host to query it again. The processor
+    // applies the factor upon its reactivation, so it is never processing at a latency the host is unaware of
+
+    if ( isLatencyChange && componentHandler != nullptr )
+        componentHandler->restartComponent( kLatencyChanged );
+
     return result;
 }
 
@@ -508,6 +578,16 @@ tresult PLUGIN_API RegraderController::getParamStringByValue( ParamID tag, Param
             return kResultTrue;
         }
 
+        // oversampling is selected in steps
+
+        case kOversamplingId:
+        {
+            const char* factors[] = { "Off", "2x", "4x", "8x" };
+            Steinberg::UString( string, 128 ).fromAscii( factors[ ( int ) round( valueNormalized * 3 ) ]);
+
+            return kResultTrue;
+        }
+
         // everything else
         default:
             return EditControllerEx1::getParamStringByValue( tag, valueNormalized, string );
@@ -69,6 +69,7 @@ class RegraderController : public EditControllerEx1, public IMidiMapping, public
 
         //---from ComponentBase-----
         tresult receiveText( const char* text ) SMTG_OVERRIDE;
+        tresult PLUGIN_API notify( IMessage* message ) SMTG_OVERRIDE;
 
         //---from IMidiMapping-----------------
         tresult PLUGIN_API getMidiControllerAssignment (int32 busIndex, int16 channel,
@@ -0,0 +1,42 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __UIDS_HEADER__
+#define __UIDS_HEADER__
+
+#include "pluginterfaces/base/fplatform.h"
+#include "pluginterfaces/base/funknown.h"
+
+using namespace Steinberg;
+
+namespace Igorski {
+namespace VST {
+
+    // the unique identifiers of the plugin classes
+
+    static const FUID RegraderProcessorUID( 0x9A615AD3, 0xFFF74B54, 0xA6AFDDE5, 0xD9995465 );
+    static const FUID RegraderWithSideChainProcessorUID( 0x31C358F3, 0x528F457D, 0xBA31BDFB, 0x70A7A2DA );
+    static const FUID RegraderControllerUID( 0xF99D622B, 0xCF48474A, 0xB7E202CD, 0x66D160D9 );
+}
+}
+
+#endif
@@ -21,9 +21,12 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "global.h"
+#include "uids.h"
 #include "vst.h"
 #include "paramids.h"
 #include "calc.h"
+#include "denormalguard.h"
+#include "kernels.h"
 
 #include "public.sdk/source/vst/vstaudioprocessoralgo.h"
 
@@ -35,51 +38,56 @@
 #include "base/source/fstreamer.h"
 
 #include <stdio.h>
+#include <algorithm>
 
 namespace Igorski {
 
 float VST::SAMPLE_RATE = 44100.f; // updated in setupProcessing()
 
+// the silence flags of given amount of channels (a flag per channel, for up to 64 channels)
+
+static uint64 getChannelMask( int32 numChannels )
+{
+    return numChannels >= 64 ? ~( uint64 ) 0 : (( uint64 ) 1 << std::max( numChannels, ( int32 ) 0 )) - 1;
+}
+
 //------------------------------------------------------------------------
 // Regrader Implementation
 //------------------------------------------------------------------------
 Regrader::Regrader()
-: fDelayTime( 0.125f )
-, fDelayHostSync( 1.f )
-, fDelayFeedback( 0.2f )
-, fDelayMix( .5f )
-, fBitResolution( 1.f )
-, fBitResolutionChain( 1.f )
-, fLFOBitResolution( .0f )
-, fLFOBitResolutionDepth( .75f )
-, fDecimator( 1.f )
-, fLFODecimator( 0.f )
-, fDecimatorChain( 0.f )
-, fFilterChain( 1.f )
-, fFilterCutoff( .5f )
-, fFilterResonance( 1.f )
-, fLFOFilter( 0.f )
-, fLFOFilterDepth( 0.5f )
-, fFlangerChain( 0.f )
-, fFlangerRate( 0.f )
-, fFlangerWidth( 0.f )
-, fFlangerFeedback( 0.f )
-, fFlangerDelay( 0.f )
-, regraderProcess( nullptr )
+: regraderProcess32( nullptr )
+, regraderProcess64( nullptr )
+, automationScheduler( nullptr )
 // , outputGainOld( 0.f )
 , currentProcessMode( -1 ) // -1 means not initialized
+, realtimeProfile( QualityProfiles::REALTIME )
+, offlineProfile( QualityProfiles::OFFLINE )
 {
     // register its editor class (the same as used in vstentry.cpp)
     setControllerClass( VST::RegraderControllerUID );
 
-    regraderProcess = new RegraderProcess( 2 );
+    ParameterModel::getDefaultValues( _model );
+    ParameterModel::getDefaultValues( _stateModel );
+
+    _activeOversampling = _model[ kOversamplingId ];
+
+    automationScheduler = new AutomationScheduler();
+
+#if defined( REGRADER_DEBUG_LOGGING )
+    // only debug builds log from the audio thread, in other builds no queue
+    // (nor the Logger's background thread draining it) is created
+    _log = new LogQueue();
+#endif
 }
 
 //------------------------------------------------------------------------
 Regrader::~Regrader()
 {
     // free all allocated resources
-    delete regraderProcess;
+    delete regraderProcess32;
+    delete regraderProcess64;
+    delete automationScheduler;
+    delete _log;
 }
 
 //------------------------------------------------------------------------
@@ -98,6 +106,9 @@ tresult PLUGIN_API Regrader::initialize( FUnknown* context )
     //---create Event In/Out buses (1 bus with only 1 channel)------
     addEventInput( STR16( "Event In" ), 1 );
 
+    //---select the DSP kernels for the instruction set of the executing CPU------
+    Igorski::Kernels::initialize();
+
     return kResultOk;
 }
 
@@ -111,10 +122,17 @@ tresult PLUGIN_API Regrader::terminate()
 //------------------------------------------------------------------------
 tresult PLUGIN_API Regrader::setActive (TBool state)
 {
-    if (state)
-        sendTextMessage( "Regrader::setActive (true)" );
-    else
-        sendTextMessage( "Regrader::setActive (false)" );
+    Logger::log( "[Regrader] setActive (%s)", state ? "true" : "false" );
+
+    // processing is halted while (de)activating, apply the most recently loaded state
+    // along with the oversampling factor (the host queries the latency upon activation)
+
+    if ( state ) {
+        consumeModelSnapshot();
+
+        _activeOversampling = _model[ kOversamplingId ];
+        syncModel();
+    }
 
     // reset output level meter
     // outputGainOld = 0.f;
@@ -131,147 +149,36 @@ tresult PLUGIN_API Regrader::process( ProcessData& data )
     // 2) Read inputs events coming from host (note on/off events)
     // 3) Apply the effect using the input buffer into the output buffer
 
+    // denormal numbers are flushed to zero for the duration of the process call, as the
+    // arithmetic on the decaying feedback state of the effects would otherwise stall the CPU
+
+    DenormalGuard denormalGuard;
+
     //---1) Read input parameter changes-----------
-    IParameterChanges* paramChanges = data.inputParameterChanges;
-    if ( paramChanges )
-    {
-        int32 numParamsChanged = paramChanges->getParameterCount();
-        // for each parameter which are some changes in this audio block:
-        for ( int32 i = 0; i < numParamsChanged; i++ )
-        {
-            IParamValueQueue* paramQueue = paramChanges->getParameterData( i );
-            if ( paramQueue )
-            {
-                ParamValue value;
-                int32 sampleOffset;
-                int32 numPoints = paramQueue->getPointCount();
-                switch ( paramQueue->getParameterId())
-                {
-                    // we use in this example only the last point of the queue.
-                    // in some wanted case for specific kind of parameter it makes sense to retrieve all points
-                    // and process the whole audio block in small blocks.
-
-                    case kDelayTimeId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fDelayTime = ( float ) value;
-                        break;
-
-                    case kDelayHostSyncId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fDelayHostSync = ( float ) value;
-                        break;
-
-                    case kDelayFeedbackId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fDelayFeedback = ( float ) value;
-                        break;
-
-                    case kDelayMixId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fDelayMix = ( float ) value;
-                        break;
-
-                    case kBitResolutionId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fBitResolution = ( float ) value;
-                        break;
-
-                    case kBitResolutionChainId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fBitResolutionChain = ( float ) value;
-                        break;
-
-                    case kLFOBitResolutionId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fLFOBitResolution = ( float ) value;
-                        break;
-
-                    case kLFOBitResolutionDepthId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fLFOBitResolutionDepth = ( float ) value;
-                        break;
-
-                    case kDecimatorId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fDecimator = ( float ) value;
-                        break;
-
-                    case kDecimatorChainId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fDecimatorChain = ( float ) value;
-                        break;
-
-                    case kLFODecimatorId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fLFODecimator = ( float ) value;
-                        break;
-
-                    case kFilterChainId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFilterChain = ( float ) value;
-                        break;
-
-                    case kFilterCutoffId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFilterCutoff = ( float ) value;
-                        break;
-
-                    case kFilterResonanceId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFilterResonance = ( float ) value;
-                        break;
-
-                    case kLFOFilterId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fLFOFilter = ( float ) value;
-                        break;
-
-                    case kLFOFilterDepthId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fLFOFilterDepth = ( float ) value;
-                        break;
-
-                    case kFlangerChainId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFlangerChain = ( float ) value;
-                        break;
-
-                    case kFlangerRateId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFlangerRate = ( float ) value;
-                        break;
-
-                    case kFlangerWidthId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFlangerWidth = ( float ) value;
-                        break;
-
-                    case kFlangerFeedbackId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFlangerFeedback = ( float ) value;
-                        break;
-
-                    case kFlangerDelayId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            fFlangerDelay = ( float ) value;
-                        break;
-
-                    case kBypassId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            _bypass = ( value > 0.5f );
-                        break;
-                }
-                syncModel();
-            }
-        }
-    }
+    // all points of all parameter queues are merged into a single list sorted by
+    // sample offset. The audio block is processed in sub blocks in between the
+    // change points, so automation is applied sample accurately (see AutomationScheduler)
+
+    automationScheduler->schedule( data.inputParameterChanges, data.numSamples );
+
+    // a model published outside of the audio thread (e.g. by loading state) is
+    // applied at the start of the block, prior to the hosts automation for this block
+
+    bool hasModelChanges = consumeModelSnapshot();
 
     // according to docs: processing context (optional, but most welcome)
 
     if ( data.processContext != nullptr ) {
-        regraderProcess->setTempo(
-            data.processContext->tempo, data.processContext->timeSigNumerator, data.processContext->timeSigDenominator
-        );
+        if ( regraderProcess32 != nullptr ) {
+            regraderProcess32->setTempo(
+                data.processContext->tempo, data.processContext->timeSigNumerator, data.processContext->timeSigDenominator
+            );
+        }
+        if ( regraderProcess64 != nullptr ) {
+            regraderProcess64->setTempo(
+                data.processContext->tempo, data.processContext->timeSigNumerator, data.processContext->timeSigDenominator
+            );
+        }
     }
 
     //---2) Read input events-------------
@@ -282,24 +189,104 @@ tresult PLUGIN_API Regrader::process( ProcessData& data )
     //---3) Process Audio---------------------
     //-------------------------------------
 
-    if ( data.numInputs == 0 || data.numOutputs == 0 )
+    bool hasAudio       = data.numInputs > 0 && data.numOutputs > 0;
+    bool isSilentOutput = true;
+
+    AutomationScheduler::SubBlock subBlock;
+
+    while ( automationScheduler->next( subBlock ))
+    {
+        if ( subBlock.numEvents > 0 )
+        {
+            for ( int32 i = 0; i < subBlock.numEvents; ++i ) {
+                LOG_RT( _log, "[Regrader] parameter %d changed to %f at offset %d",
+                        ( int ) subBlock.events[ i ].paramId, subBlock.events[ i ].value, ( int ) subBlock.offset );
+
+                applyParameterChange( subBlock.events[ i ].paramId, subBlock.events[ i ].value );
+            }
+            syncModel();
+            hasModelChanges = true;
+        }
+
+        if ( hasAudio && subBlock.length > 0 ) {
+            isSilentOutput = processSubBlock( data, subBlock.offset, subBlock.length ) && isSilentOutput;
+        }
+    }
+
+    // hand the changed model back to the non-audio threads (for getState())
+
+    if ( hasModelChanges )
+        publishProcessedModel();
+
+    if ( !hasAudio )
     {
         // nothing to do
         return kResultOk;
     }
 
-    int32 numInChannels  = data.inputs[ 0 ].numChannels;
+    // output flags
+
     int32 numOutChannels = data.outputs[ 0 ].numChannels;
+    data.outputs[ 0 ].silenceFlags = isSilentOutput ? getChannelMask( numOutChannels ) : 0;
+ 
+    // float outputGain = regraderProcess32->limiter->getLinearGR();
+
+    // //---4) Write output parameter changes-----------
+    // IParameterChanges* outParamChanges = data.outputParameterChanges;
+    // // a new value of VuMeter will be sent to the host
+    // // (the host will send it back in sync to our controller for updating our editor)
+    // if ( !isDoublePrecision && outParamChanges && outputGainOld != outputGain ) {
+    //     int32 index = 0;
+    //     IParamValueQueue* paramQueue = outParamChanges->addParameterData( kVuPPMId, index );
+    //     if ( paramQueue )
+    //         paramQueue->addPoint( 0, outputGain, index );
+    // }
+    // outputGainOld = outputGain;
+    return kResultOk;
+}
+
+//------------------------------------------------------------------------
+bool Regrader::processSubBlock( ProcessData& data, int32 offset, int32 numSamples )
+{
+    // the pointer lists (and the processor) are sized to the bus arrangement in setupProcessing, a host
+    // providing more channels than negotiated only has the negotiated channels processed, its other
+    // output channels are silenced (this keeps the automation sample accurate for all channels)
+
+    int32 numInChannels  = std::min( data.inputs[ 0 ].numChannels,  ( int32 ) _subBlockInputs.size() );
+    int32 numOutChannels = std::min( data.outputs[ 0 ].numChannels, ( int32 ) _subBlockOutputs.size() );
 
     // --- get audio buffers----------------
-    uint32 sampleFramesSize = getSampleFramesSizeInBytes( processSetup, data.numSamples );
+    uint32 sampleFramesSize = getSampleFramesSizeInBytes( processSetup, numSamples );
+    uint32 offsetInBytes    = getSampleFramesSizeInBytes( processSetup, offset );
     void** in  = getChannelBuffersPointer( processSetup, data.inputs [ 0 ] );
     void** out = getChannelBuffersPointer( processSetup, data.outputs[ 0 ] );
 
+    for ( int32 c = numOutChannels; c < data.outputs[ 0 ].numChannels; ++c ) {
+        memset(( char* ) out[ c ] + offsetInBytes, 0, sampleFramesSize );
+    }
+
+    // point the channel buffers to the start of the sub block
+
+    if ( offset > 0 )
+    {
+        for ( int32 c = 0; c < numInChannels; ++c ) {
+            _subBlockInputs[ c ] = ( char* ) in[ c ] + offsetInBytes;
+        }
+        for ( int32 c = 0; c < numOutChannels; ++c ) {
+            _subBlockOutputs[ c ] = ( char* ) out[ c ] + offsetInBytes;
+        }
+        in  = _subBlockInputs.data();
+        out = _subBlockOutputs.data();
+    }
+
     // process the incoming sound!
 
+    // the input is silent when the host has flagged all of its channels as such
+
+    uint64 inputChannelMask = getChannelMask( numInChannels );
+
     bool isDoublePrecision = data.symbolicSampleSize == kSample64;
-    bool isSilentInput  = data.inputs[ 0 ].silenceFlags != 0;
+    bool isSilentInput  = ( data.inputs[ 0 ].silenceFlags & inputChannelMask ) == inputChannelMask;
     bool isSilentOutput = false;
 
     if ( _bypass )
@@ -314,53 +301,114 @@ tresult PLUGIN_API Regrader::process( ProcessData& data )
             isSilentOutput = isSilentInput;
         }
     } else {
-        if ( isDoublePrecision ) {
+        // note the processor for the sample size is created in setupProcessing
+
+        // when the input is silent and the effect tails have decayed, the output will be
+        // silent too: skip processing altogether (the processor would otherwise determine this
+        // by inspecting the input, which is unnecessary when the host has flagged it as silent)
+
+        bool isIdle = ( isDoublePrecision && regraderProcess64 != nullptr && regraderProcess64->isIdle()) ||
+                      ( !isDoublePrecision && regraderProcess32 != nullptr && regraderProcess32->isIdle());
+
+        if ( isSilentInput && isIdle )
+        {
+            for ( int32 i = 0; i < numOutChannels; i++ ) {
+                memset( out[ i ], 0, sampleFramesSize );
+            }
+        }
+        else if ( isDoublePrecision ) {
             // 64-bit samples, e.g. Reaper64
-            regraderProcess->process<double>(
-                ( double** ) in, ( double** ) out, numInChannels, numOutChannels,
-                data.numSamples, sampleFramesSize
-            );
+            if ( regraderProcess64 != nullptr ) {
+                regraderProcess64->process(
+                    ( double** ) in, ( double** ) out, numInChannels, numOutChannels,
+                    numSamples, sampleFramesSize
+                );
+                isIdle = regraderProcess64->isIdle();
+            }
         }
-        else {
+        else if ( regraderProcess32 != nullptr ) {
             // 32-bit samples, e.g. Ableton Live, Bitwig Studio... (oddly enough also when 64-bit?)
-            regraderProcess->process<float>(
+            regraderProcess32->process(
                 ( float** ) in, ( float** ) out, numInChannels, numOutChannels,
-                data.numSamples, sampleFramesSize
+                numSamples, sampleFramesSize
             );
+            isIdle = regraderProcess32->isIdle();
         }
+        // the output of an idle processor is silent
+
+        isSilentOutput = isIdle;
     }
+    return isSilentOutput;
+}
 
-    // output flags
+//------------------------------------------------------------------------
+void Regrader::applyParameterChange( ParamID paramId, ParamValue value )
+{
+    if ( paramId >= kNumParameters )
+        return;
 
-    data.outputs[ 0 ].silenceFlags = isSilentOutput ? (( uint64 ) 1 << numOutChannels ) - 1 : 0;
- 
-    // float outputGain = regraderProcess->limiter->getLinearGR();
+    _model[ paramId ] = ( float ) value;
 
-    // //---4) Write output parameter changes-----------
-    // IParameterChanges* outParamChanges = data.outputParameterChanges;
-    // // a new value of VuMeter will be sent to the host
-    // // (the host will send it back in sync to our controller for updating our editor)
-    // if ( !isDoublePrecision && outParamChanges && outputGainOld != outputGain ) {
-    //     int32 index = 0;
-    //     IParamValueQueue* paramQueue = outParamChanges->addParameterData( kVuPPMId, index );
-    //     if ( paramQueue )
-    //         paramQueue->addPoint( 0, outputGain, index );
-    // }
-    // outputGainOld = outputGain;
-    return kResultOk;
+    if ( paramId == kBypassId )
+        _bypass = ( value > 0.5f );
 }
 
 //------------------------------------------------------------------------
 tresult Regrader::receiveText( const char* text )
 {
     // received from Controller
-    fprintf( stderr, "[Regrader] received: " );
-    fprintf( stderr, "%s", text );
-    fprintf( stderr, "\n" );
+    Logger::log( "[Regrader] received: %s", text );
+
+    if ( Igorski::Profiler::ENABLED && text != nullptr && !strcmp( text, "profile" ))
+        sendProfilerStatistics();
 
     return kResultOk;
 }
 
+//------------------------------------------------------------------------
+void Regrader::sendProfilerStatistics()
+{
+    // invoked on the UI thread, the statistics are read without blocking the audio thread (see profiler.h)
+
+    Igorski::Profiler* profiler = nullptr;
+
+    if ( regraderProcess64 != nullptr )
+        profiler = regraderProcess64->profiler;
+    else if ( regraderProcess32 != nullptr )
+        profiler = regraderProcess32->profiler;
+
+    if ( profiler == nullptr )
+        return;
+
+    Igorski::Profiler::Statistics statistics[ Igorski::Profiler::STAGE_COUNT ];
+    profiler->getStatistics( statistics );
+
+    IPtr<IMessage> message = owned( allocateMessage() );
+
+    if ( !message )
+        return;
+
+    message->setMessageID( "ProfilerStatistics" );
+    message->getAttributes()->setBinary( "statistics", statistics, sizeof( statistics ));
+
+    sendMessage( message );
+}
+
+//------------------------------------------------------------------------
+void Regrader::sendLatencyChanged()
+{
+    // the component cannot restart itself, the controller requests the host to do so (see RegraderController::notify)
+
+    IPtr<IMessage> message = owned( allocateMessage() );
+
+    if ( !message )
+        return;
+
+    message->setMessageID( "LatencyChanged" );
+
+    sendMessage( message );
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API Regrader::setState( IBStream* state )
 {
@@ -452,35 +500,54 @@ tresult PLUGIN_API Regrader::setState( IBStream* state )
     if ( streamer.readFloat( savedFlangerDelay ) == false )
         return kResultFalse;
 
-    // may fail as this was only added in version 1.0.5.1
-    int32 savedBypass = 0;
-    if ( streamer.readInt32( savedBypass ) != false ) {
-        _bypass = savedBypass;
-    }
-
-    fDelayTime             = savedDelayTime;
-    fDelayHostSync         = savedDelayHostSync;
-    fDelayFeedback         = savedDelayFeedback;
-    fDelayMix              = savedDelayMix;
-    fBitResolution         = savedBitResolution;
-    fBitResolutionChain    = savedBitResolutionChain;
-    fLFOBitResolution      = savedLFOBitResolution;
-    fLFOBitResolutionDepth = savedLFOBitResolutionDepth;
-    fDecimator             = savedDecimator;
-    fDecimatorChain        = savedDecimatorChain;
-    fLFODecimator          = savedLFODecimator;
-    fFilterChain           = savedFilterChain;
-    fFilterCutoff          = savedFilterCutoff;
-    fFilterResonance       = savedFilterResonance;
-    fLFOFilter             = savedLFOFilter;
-    fLFOFilterDepth        = savedLFOFilterDepth;
-    fFlangerChain          = savedFlangerChain;
-    fFlangerRate           = savedFlangerRate;
-    fFlangerWidth          = savedFlangerWidth;
-    fFlangerFeedback       = savedFlangerFeedback;
-    fFlangerDelay          = savedFlangerDelay;
-
-    syncModel();
+    // the current values are those last known outside of the audio thread (the audio thread owns _model)
+
+    consumeProcessedModel();
+
+    // may fail as this was only added in version 1.0.5.1 (in which case we keep the current value)
+    int32 savedBypass = _stateModel[ kBypassId ] > 0.5f ? 1 : 0;
+    streamer.readInt32( savedBypass );
+
+    // may fail as this was added after the bypass (in which case we keep the current value)
+    float savedOversampling = _stateModel[ kOversamplingId ];
+    streamer.readFloat( savedOversampling );
+
+    // we are not on the audio thread, as such we do not update the model directly
+    // but publish it in its entirety, it is picked up at the start of the next process cycle
+    // the loaded values are kept as the state, until the audio thread publishes a model deriving from them
+
+    float* values = _stateModel;
+
+    values[ kDelayTimeId ]             = savedDelayTime;
+    values[ kDelayHostSyncId ]         = savedDelayHostSync;
+    values[ kDelayFeedbackId ]         = savedDelayFeedback;
+    values[ kDelayMixId ]              = savedDelayMix;
+    values[ kBitResolutionId ]         = savedBitResolution;
+    values[ kBitResolutionChainId ]    = savedBitResolutionChain;
+    values[ kLFOBitResolutionId ]      = savedLFOBitResolution;
+    values[ kLFOBitResolutionDepthId ] = savedLFOBitResolutionDepth;
+    values[ kDecimatorId ]             = savedDecimator;
+    values[ kDecimatorChainId ]        = savedDecimatorChain;
+    values[ kLFODecimatorId ]          = savedLFODecimator;
+    values[ kFilterChainId ]           = savedFilterChain;
+    values[ kFilterCutoffId ]          = savedFilterCutoff;
+    values[ kFilterResonanceId ]       = savedFilterResonance;
+    values[ kLFOFilterId ]             = savedLFOFilter;
+    values[ kLFOFilterDepthId ]        = savedLFOFilterDepth;
+    values[ kFlangerChainId ]          = savedFlangerChain;
+    values[ kFlangerRateId ]           = savedFlangerRate;
+    values[ kFlangerWidthId ]          = savedFlangerWidth;
+    values[ kFlangerFeedbackId ]       = savedFlangerFeedback;
+    values[ kFlangerDelayId ]          = savedFlangerDelay;
+    values[ kBypassId ]                = savedBypass;
+    values[ kOversamplingId ]          = savedOversampling;
+
+    ModelSnapshot& snapshot = _modelSnapshots.getWriteBuffer();
+
+    std::copy( _stateModel, _stateModel + kNumParameters, snapshot.values );
+    snapshot.version = ++_stateVersion;
+
+    _modelSnapshots.publish();
 
     // Example of using the IStreamAttributes interface
     FUnknownPtr<IStreamAttributes> stream (state);
@@ -522,28 +589,20 @@ tresult PLUGIN_API Regrader::getState( IBStream* state )
 
     IBStreamer streamer( state, kLittleEndian );
 
-    streamer.writeFloat( fDelayTime );
-    streamer.writeFloat( fDelayHostSync );
-    streamer.writeFloat( fDelayFeedback );
-    streamer.writeFloat( fDelayMix );
-    streamer.writeFloat( fBitResolution );
-    streamer.writeFloat( fBitResolutionChain );
-    streamer.writeFloat( fLFOBitResolution );
-    streamer.writeFloat( fLFOBitResolutionDepth );
-    streamer.writeFloat( fDecimator );
-    streamer.writeFloat( fDecimatorChain );
-    streamer.writeFloat( fLFODecimator );
-    streamer.writeFloat( fFilterChain );
-    streamer.writeFloat( fFilterCutoff );
-    streamer.writeFloat( fFilterResonance );
-    streamer.writeFloat( fLFOFilter );
-    streamer.writeFloat( fLFOFilterDepth );
-    streamer.writeFloat( fFlangerChain );
-    streamer.writeFloat( fFlangerRate );
-    streamer.writeFloat( fFlangerWidth );
-    streamer.writeFloat( fFlangerFeedback );
-    streamer.writeFloat( fFlangerDelay );
-    streamer.writeInt32( _bypass ? 1 : 0 );
+    // we are not on the audio thread, as such we do not read the model directly but the values last
+    // loaded or published by the audio thread (which is not processing when the plugin is inactive)
+
+    consumeProcessedModel();
+
+    // the state is written in order of the parameter ids (as such parameters
+    // should be appended, for the states of previous versions to remain readable)
+
+    for ( int32 paramId = 0; paramId < kNumParameters; ++paramId ) {
+        if ( paramId == kBypassId )
+            streamer.writeInt32( _stateModel[ paramId ] > 0.5f ? 1 : 0 );
+        else
+            streamer.writeFloat( _stateModel[ paramId ]);
+    }
 
     return kResultOk;
 }
@@ -553,13 +612,71 @@ tresult PLUGIN_API Regrader::setupProcessing( ProcessSetup& newSetup )
 {
     // called before the process call, always in a disabled state (not active)
 
+    // the latency the host was informed of (the processor is recreated when the sample size changes)
+
+    bool hasProcessor      = regraderProcess32 != nullptr || regraderProcess64 != nullptr;
+    uint32 previousLatency = getLatencySamples();
+
     // here we keep a trace of the processing mode (offline,...) for example.
     currentProcessMode = newSetup.processMode;
 
     VST::SAMPLE_RATE = newSetup.sampleRate;
 
+    // size the sub block channel pointer lists to the bus arrangement
+
+    AudioBus* inputBus  = FCast<AudioBus>( audioInputs.at( 0 ));
+    AudioBus* outputBus = FCast<AudioBus>( audioOutputs.at( 0 ));
+
+    int32 numInChannels  = inputBus  ? SpeakerArr::getChannelCount( inputBus->getArrangement())  : 0;
+    int32 numOutChannels = outputBus ? SpeakerArr::getChannelCount( outputBus->getArrangement()) : 0;
+
+    _subBlockInputs.resize ( numInChannels,  nullptr );
+    _subBlockOutputs.resize( numOutChannels, nullptr );
+
+    // the audio is processed at the precision requested by the host, only the
+    // processor for the requested sample size is kept, with all of its channel
+    // specific state sized to the bus arrangement and its buffers sized to hold
+    // the largest block the host will deliver (no allocation occurs while processing)
+
+    int32 amountOfChannels = std::max( numInChannels, ( int32 ) 1 );
+    int32 maxBufferSize    = std::max( newSetup.maxSamplesPerBlock, ( int32 ) 1 );
+
+    if ( newSetup.symbolicSampleSize == kSample64 ) {
+        delete regraderProcess32;
+        regraderProcess32 = nullptr;
+
+        if ( regraderProcess64 == nullptr )
+            regraderProcess64 = new RegraderProcess<double>( amountOfChannels, maxBufferSize );
+
+        regraderProcess64->setAmountOfChannels( amountOfChannels );
+        regraderProcess64->setMaxBufferSize( maxBufferSize );
+        regraderProcess64->updateSampleRate();
+    }
+    else {
+        delete regraderProcess64;
+        regraderProcess64 = nullptr;
+
+        if ( regraderProcess32 == nullptr )
+            regraderProcess32 = new RegraderProcess<float>( amountOfChannels, maxBufferSize );
+
+        regraderProcess32->setAmountOfChannels( amountOfChannels );
+        regraderProcess32->setMaxBufferSize( maxBufferSize );
+        regraderProcess32->updateSampleRate();
+    }
+
+    // we are in a disabled state, so we can safely take ownership of the most recently published model
+
+    consumeModelSnapshot();
+
+    _activeOversampling = _model[ kOversamplingId ];
     syncModel();
 
+    // the quality profile of the processing mode can change the oversampling factor and thus the
+    // latency (e.g. when the host starts rendering offline), for which the host has to be notified
+
+    if ( hasProcessor && getLatencySamples() != previousLatency )
+        sendLatencyChanged();
+
     return AudioEffect::setupProcessing( newSetup );
 }
 
@@ -567,8 +684,11 @@ tresult PLUGIN_API Regrader::setupProcessing( ProcessSetup& newSetup )
 tresult PLUGIN_API Regrader::setBusArrangements( SpeakerArrangement* inputs,  int32 numIns,
                                                  SpeakerArrangement* outputs, int32 numOuts )
 {
-    bool isMonoInOut   = SpeakerArr::getChannelCount( inputs[ 0 ]) == 1 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 1;
-    bool isStereoInOut = SpeakerArr::getChannelCount( inputs[ 0 ]) == 2 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 2;
+    int32 numInChannels  = SpeakerArr::getChannelCount( inputs[ 0 ]);
+    int32 numOutChannels = SpeakerArr::getChannelCount( outputs[ 0 ]);
+
+    bool isMonoInOut   = numInChannels == 1 && numOutChannels == 1;
+    bool isStereoInOut = numInChannels == 2 && numOutChannels == 2;
 #ifdef BUILD_AUDIO_UNIT
     if ( !isMonoInOut && !isStereoInOut ) {
         return AudioEffect::setBusArrangements( inputs, numIns, outputs, numOuts ); // solves auval 4099 error
@@ -576,45 +696,43 @@ tresult PLUGIN_API Regrader::setBusArrangements( SpeakerArrangement* inputs,  in
 #endif
     if ( numIns == 1 && numOuts == 1 )
     {
-        if ( isMonoInOut )
+        AudioBus* inputBus  = FCast<AudioBus>( audioInputs.at( 0 ));
+        AudioBus* outputBus = FCast<AudioBus>( audioOutputs.at( 0 ));
+
+        if ( inputBus && outputBus )
         {
-            AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
-            if ( bus )
+            // any arrangement (mono, stereo, surround...) is supported as long as
+            // the input and output have the same amount of channels
+            if ( numInChannels > 0 && numInChannels == numOutChannels )
             {
-                // check if we are Mono => Mono, if not we need to recreate the buses
-                if ( bus->getArrangement() != inputs[ 0 ])
+                // check if the requested arrangement differs from the current one, if so we need to recreate the buses
+                if ( inputBus->getArrangement() != inputs[ 0 ] || outputBus->getArrangement() != outputs[ 0 ])
                 {
                     removeAudioBusses();
-                    addAudioInput ( STR16( "Mono In" ),  inputs[ 0 ] );
-                    addAudioOutput( STR16( "Mono Out" ), outputs[ 0 ] );
+
+                    if ( isMonoInOut ) {
+                        addAudioInput ( STR16( "Mono In" ),  inputs[ 0 ] );
+                        addAudioOutput( STR16( "Mono Out" ), outputs[ 0 ] );
+                    }
+                    else if ( isStereoInOut ) {
+                        addAudioInput ( STR16( "Stereo In" ),  inputs[ 0 ] );
+                        addAudioOutput( STR16( "Stereo Out" ), outputs[ 0 ] );
+                    }
+                    else {
+                        addAudioInput ( STR16( "Multichannel In" ),  inputs[ 0 ] );
+                        addAudioOutput( STR16( "Multichannel Out" ), outputs[ 0 ] );
+                    }
                 }
-                return kResultOk;
+                return kResultTrue;
             }
-        }
-        // the host wants something else than Mono => Mono, in this case we are always Stereo => Stereo
-        else
-        {
-            AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
-            if ( bus )
+            // the host wants a different amount of input and output channels : in this case we want stereo
+            else if ( inputBus->getArrangement() != SpeakerArr::kStereo )
             {
-                // the host wants 2->2 (could be LsRs -> LsRs)
-                if ( isStereoInOut )
-                {
-                    removeAudioBusses();
-                    addAudioInput  ( STR16( "Stereo In"),  inputs [ 0 ] );
-                    addAudioOutput ( STR16( "Stereo Out"), outputs[ 0 ]);
+                removeAudioBusses();
+                addAudioInput ( STR16( "Stereo In"),  SpeakerArr::kStereo );
+                addAudioOutput( STR16( "Stereo Out"), SpeakerArr::kStereo );
 
-                    return kResultTrue;
-                }
-                // the host want something different than 1->1 or 2->2 : in this case we want stereo
-                else if ( bus->getArrangement() != SpeakerArr::kStereo )
-                {
-                    removeAudioBusses();
-                    addAudioInput ( STR16( "Stereo In"),  SpeakerArr::kStereo );
-                    addAudioOutput( STR16( "Stereo Out"), SpeakerArr::kStereo );
-                    
-                    return kResultFalse;
-                }
+                return kResultFalse;
             }
         }
     }
@@ -634,6 +752,38 @@ tresult PLUGIN_API Regrader::canProcessSampleSize( int32 symbolicSampleSize )
     return kResultFalse;
 }
 
+//------------------------------------------------------------------------
+uint32 PLUGIN_API Regrader::getTailSamples()
+{
+    // note the processor for the sample size is created in setupProcessing
+
+    double tailSamples = 0.0;
+
+    if ( regraderProcess64 != nullptr )
+        tailSamples = regraderProcess64->getTailSamples();
+    else if ( regraderProcess32 != nullptr )
+        tailSamples = regraderProcess32->getTailSamples();
+
+    if ( tailSamples >= ( double ) kInfiniteTail )
+        return kInfiniteTail;
+
+    return ( uint32 ) ceil( tailSamples );
+}
+
+//------------------------------------------------------------------------
+uint32 PLUGIN_API Regrader::getLatencySamples()
+{
+    // note the processor for the sample size is created in setupProcessing
+
+    if ( regraderProcess64 != nullptr )
+        return regraderProcess64->getLatency();
+
+    if ( regraderProcess32 != nullptr )
+        return regraderProcess32->getLatency();
+
+    return 0;
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API Regrader::notify( IMessage* message )
 {
@@ -650,7 +800,7 @@ tresult PLUGIN_API Regrader::notify( IMessage* message )
             // size should be 100
             if ( size == 100 && ((char*)data)[1] == 1 ) // yeah...
             {
-                fprintf( stderr, "[Regrader] received the binary message!\n" );
+                Logger::log( "[Regrader] received the binary message!" );
             }
             return kResultOk;
         }
@@ -659,28 +809,67 @@ tresult PLUGIN_API Regrader::notify( IMessage* message )
     return AudioEffect::notify( message );
 }
 
+bool Regrader::consumeModelSnapshot()
+{
+    if ( !_modelSnapshots.consume())
+        return false;
+
+    const ModelSnapshot& snapshot = _modelSnapshots.getReadBuffer();
+
+    for ( int32 paramId = 0; paramId < kNumParameters; ++paramId ) {
+        applyParameterChange( paramId, snapshot.values[ paramId ]);
+    }
+    _modelVersion = snapshot.version;
+    syncModel();
+
+    return true;
+}
+
+void Regrader::publishProcessedModel()
+{
+    ModelSnapshot& snapshot = _processedSnapshots.getWriteBuffer();
+
+    std::copy( _model, _model + kNumParameters, snapshot.values );
+    snapshot.version = _modelVersion;
+
+    _processedSnapshots.publish();
+}
+
+void Regrader::consumeProcessedModel()
+{
+    // a model published prior to the audio thread picking up the last loaded state is outdated
+
+    if ( !_processedSnapshots.consume())
+        return;
+
+    const ModelSnapshot& snapshot = _processedSnapshots.getReadBuffer();
+
+    if ( snapshot.version == _stateVersion )
+        std::copy( snapshot.values, snapshot.values + kNumParameters, _stateModel );
+}
+
+template <typename SampleType>
+void Regrader::syncProcessorModel( RegraderProcess<SampleType>* process )
+{
+    // when the host renders offline (e.g. bouncing) the output is not bound by the audio
+    // deadline, as such the processor can apply its most precise (and costly) settings
+
+    // the oversampling factor is only changed while inactive (see _activeOversampling)
+
+    float values[ kNumParameters ];
+    std::copy( _model, _model + kNumParameters, values );
+    values[ kOversamplingId ] = _activeOversampling;
+
+    ParameterModel::apply( values, process, currentProcessMode == kOffline ? offlineProfile : realtimeProfile );
+}
+
 void Regrader::syncModel()
 {
-    regraderProcess->syncDelayToHost = Calc::toBool( fDelayHostSync );
-    regraderProcess->setDelayTime( fDelayTime );
-    regraderProcess->setDelayFeedback( fDelayFeedback );
-    regraderProcess->setDelayMix( fDelayMix );
-
-    regraderProcess->bitCrusherPostMix = Calc::toBool( fBitResolutionChain );
-    regraderProcess->decimatorPostMix  = Calc::toBool( fDecimatorChain );
-    regraderProcess->filterPostMix     = Calc::toBool( fFilterChain );
-    regraderProcess->flangerPostMix    = Calc::toBool( fFlangerChain );
-
-    regraderProcess->bitCrusher->setAmount( fBitResolution );
-    regraderProcess->bitCrusher->setLFO( fLFOBitResolution, fLFOBitResolutionDepth );
-    regraderProcess->decimator->setBits( ( int )( fDecimator * 32.f ));
-    regraderProcess->decimator->setRate( fLFODecimator );
-    regraderProcess->filter->updateProperties( fFilterCutoff, fFilterResonance, fLFOFilter, fLFOFilterDepth );
-
-    regraderProcess->flanger->setRate( fFlangerRate );
-    regraderProcess->flanger->setWidth( fFlangerWidth );
-    regraderProcess->flanger->setFeedback( fFlangerFeedback );
-    regraderProcess->flanger->setDelay( fFlangerDelay );
+    if ( regraderProcess32 != nullptr )
+        syncProcessorModel( regraderProcess32 );
+
+    if ( regraderProcess64 != nullptr )
+        syncProcessorModel( regraderProcess64 );
 }
 
 }
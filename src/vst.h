@@ -24,9 +24,16 @@
 #define _VST_HEADER__
 
 #include "public.sdk/source/vst/vstaudioeffect.h"
+#include "automationscheduler.h"
+#include "logger.h"
 #include "regraderprocess.h"
+#include "triplebuffer.h"
+#include "paramids.h"
+#include "parametermodel.h"
 #include "global.h"
+#include <vector>
 
+using namespace Steinberg;
 using namespace Steinberg::Vst;
 
 namespace Igorski {
@@ -79,6 +86,12 @@ class Regrader : public AudioEffect
         /** Asks if a given sample size is supported see \ref SymbolicSampleSizes. */
         tresult PLUGIN_API canProcessSampleSize( int32 symbolicSampleSize ) SMTG_OVERRIDE;
 
+        /** Gets the current tail length in samples (e.g. the decay of the delay feedback) */
+        uint32 PLUGIN_API getTailSamples() SMTG_OVERRIDE;
+
+        /** Gets the current latency in samples (e.g. introduced by oversampling) */
+        uint32 PLUGIN_API getLatencySamples() SMTG_OVERRIDE;
+
         /** We want to receive message. */
         tresult PLUGIN_API notify( IMessage* message ) SMTG_OVERRIDE;
 
@@ -86,45 +99,103 @@ class Regrader : public AudioEffect
     protected:
         //==============================================================================
 
-        // our model values, these are all 0 - 1 range
-        // (normalized) RangeParameter values
+        // our model values, normalized (0 - 1 range) and indexed by parameter id
+        // these are translated onto the processor by the ParameterModel
+
+        float _model[ kNumParameters ];
+
+        // float outputGainOld; // for visualizing output gain in DAW
+        bool _bypass { false };
 
-        float fDelayTime;
-        float fDelayHostSync;
-        float fDelayFeedback;
-        float fDelayMix;
+        // a complete copy of the model (normalized values indexed by parameter id)
+        // published by non-audio threads (e.g. when loading state) and picked up
+        // by the audio thread at the start of the next process cycle. The version
+        // identifies the loaded state the values originate from
 
-        float fBitResolution;
-        float fBitResolutionChain;
-        float fLFOBitResolution;
-        float fLFOBitResolutionDepth;
+        struct ModelSnapshot {
+            float values[ kNumParameters ];
+            uint32 version;
+        };
+        TripleBuffer<ModelSnapshot> _modelSnapshots;
 
-        float fDecimator;
-        float fDecimatorChain;
-        float fLFODecimator;
+        // the model as changed by the audio thread (e.g. by automation), published
+        // back to the non-audio threads so getState() serializes the current values
 
-        float fFilterChain;
-        float fFilterCutoff;
-        float fFilterResonance;
-        float fLFOFilter;
-        float fLFOFilterDepth;
+        TripleBuffer<ModelSnapshot> _processedSnapshots;
+        uint32 _modelVersion { 0 }; // audio thread: the version of the loaded state _model derives from
 
-        float fFlangerChain;
-        float fFlangerRate;
-        float fFlangerWidth;
-        float fFlangerFeedback;
-        float fFlangerDelay;
+        // the model as known to the non-audio threads (e.g. the last loaded state or the
+        // most recent model published by the audio thread), serialized by getState()
 
-        // float outputGainOld; // for visualizing output gain in DAW
-        bool _bypass { false };
+        float _stateModel[ kNumParameters ];
+        uint32 _stateVersion { 0 };
 
         int32 currentProcessMode;
 
-        Igorski::RegraderProcess* regraderProcess;
+        // the oversampling (normalized model value) applied onto the processor. As the oversampling factor
+        // determines the latency it is only applied while the plugin is inactive (see setActive), after the
+        // host was requested to reactivate the plugin and query its latency (see RegraderController)
+
+        float _activeOversampling;
+
+        // the quality settings applied while processing in realtime and while
+        // rendering offline (see setupProcessing), defaults are in regraderprocess.h
+
+        Igorski::QualityProfile realtimeProfile;
+        Igorski::QualityProfile offlineProfile;
+
+        // the processor for the sample size requested by the host (see setupProcessing)
+        // these are created in setupProcessing, only one exists at a time (the other is null)
+
+        Igorski::RegraderProcess<float>*  regraderProcess32;
+        Igorski::RegraderProcess<double>* regraderProcess64;
+        Igorski::AutomationScheduler* automationScheduler;
+
+        // messages logged from the audio thread (see logger.h), debug builds only
+
+        Igorski::LogQueue* _log { nullptr };
+
+        // channel buffer pointers offset to the start of the current sub block
+        // (sized in setupProcessing so no allocation occurs during processing)
+
+        std::vector<void*> _subBlockInputs;
+        std::vector<void*> _subBlockOutputs;
 
         // synchronize the processors model with UI led changes
 
         void syncModel();
+
+        template <typename SampleType>
+        void syncProcessorModel( Igorski::RegraderProcess<SampleType>* process );
+
+        // apply the most recently published model snapshot (if any), returns whether
+        // the model was updated. Must be called from the thread owning the processor
+
+        bool consumeModelSnapshot();
+
+        // publish the model to the non-audio threads (audio thread) and pick up the most recently
+        // published model, provided it derives from the last loaded state (non-audio threads)
+
+        void publishProcessedModel();
+        void consumeProcessedModel();
+
+        // update the model value for given parameter (value in normalized 0 - 1 range)
+
+        void applyParameterChange( ParamID paramId, ParamValue value );
+
+        // process given range of the current audio block, returns whether the output is silent
+
+        bool processSubBlock( ProcessData& data, int32 offset, int32 numSamples );
+
+        // send the profiling statistics of the processor to the controller (when compiled with REGRADER_PROFILING)
+        // requested by the controller by sending the text "profile"
+
+        void sendProfilerStatistics();
+
+        // request the controller to have the host query the latency again (e.g. when switching to
+        // offline processing selects a quality profile with a different oversampling factor)
+
+        void sendLatencyChanged();
 };
 
 }
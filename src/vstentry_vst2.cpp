@@ -22,6 +22,7 @@
  */
 #include "public.sdk/source/vst/vst2wrapper/vst2wrapper.h"
 #include "global.h"
+#include "uids.h"
 
 //------------------------------------------------------------------------
 ::AudioEffect* createEffectInstance (audioMasterCallback audioMaster)
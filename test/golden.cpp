@@ -0,0 +1,366 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "../src/parametermodel.h"
+#include "../src/denormalguard.h"
+#include "../render/wavefile.h"
+#include "realtimeguard.h"
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * renders fixed test signals through RegraderProcess for a matrix of parameter presets
+ * (covering each effect, the routing of the effects before or after the delay and both
+ * quality profiles) and compares the output against the stored reference renders in
+ * test/golden. This validates that optimizations of the DSP (e.g. the kernels of each
+ * instruction set supported by the executing CPU) leave the sound of the effect intact
+ *
+ * usage: regrader-golden-test <reference directory> [--update]
+ * where --update (re)writes the reference renders from the current implementation
+ */
+namespace Igorski {
+float VST::SAMPLE_RATE = 44100.f; // normally set by the plugin, see vst.cpp
+}
+
+using namespace Igorski;
+
+namespace {
+
+const int SAMPLE_RATE  = 44100;
+const int NUM_CHANNELS = 2;
+const int LENGTH       = 8192; // in frames
+const int BLOCK_SIZE   = 512;
+const double TEMPO     = 120.0;
+
+enum Signal {
+    IMPULSE,
+    SWEEP,
+    NOISE,
+    SIGNAL_COUNT
+};
+
+const char* SIGNAL_NAMES[ SIGNAL_COUNT ] = { "impulse", "sweep", "noise" };
+
+// the maximum deviation of a single sample and the minimum depth (in dB) of the difference between
+// the output and the reference relative to the reference. Quantizing stages (the bit crusher and
+// decimator) are granted a larger deviation, as the smallest difference in their input can move a
+// sample onto another quantization step. Modulated stages interpolate between LFO driven values
+
+struct Tolerance {
+    double maxError;
+    double nullDepth;
+};
+
+const Tolerance LINEAR    = { 1e-4, -90.0 };
+const Tolerance MODULATED = { 1e-3, -70.0 };
+const Tolerance QUANTIZED = { .25,  -50.0 };
+
+struct Parameter {
+    int id;
+    float value;
+};
+
+struct Preset {
+    const char* name;
+    std::vector<Parameter> parameters; // applied onto the defaults and the base below
+    bool offline;                      // whether to use the offline quality profile
+    Tolerance tolerance;
+};
+
+// the base onto which the presets are applied: as the effects process the wet signal, the output
+// consists of the wet signal only, where the delay outputs a single (40 ms delayed) copy of the input
+
+const std::vector<Parameter> BASE = {
+    { kDelayHostSyncId, 0.f }, { kDelayTimeId, .008f }, { kDelayFeedbackId, 0.f }, { kDelayMixId, 1.f },
+    { kFilterCutoffId, 1.f }, { kFilterResonanceId, .5f }
+};
+
+const std::vector<Preset> PRESETS = {
+    { "delay", {
+        { kDelayTimeId, .008f }, { kDelayFeedbackId, .5f }, { kDelayMixId, .5f }
+    }, false, LINEAR },
+    { "delay-synced", {
+        { kDelayHostSyncId, 1.f }, { kDelayTimeId, .02f }, { kDelayFeedbackId, .7f }, { kDelayMixId, .8f }
+    }, false, LINEAR },
+    { "bitcrusher", {
+        { kBitResolutionId, .2f }, { kBitResolutionChainId, 0.f }, { kLFOBitResolutionId, .3f }, { kLFOBitResolutionDepthId, .75f },
+        { kDelayFeedbackId, .4f }, { kDelayMixId, .5f }
+    }, false, QUANTIZED },
+    { "decimator", {
+        { kDecimatorId, .25f }, { kDecimatorChainId, 1.f }, { kLFODecimatorId, .5f },
+        { kDelayFeedbackId, .4f }, { kDelayMixId, .5f }
+    }, false, QUANTIZED },
+    { "filter", {
+        { kFilterCutoffId, .3f }, { kFilterResonanceId, .7f }, { kFilterChainId, 0.f }
+    }, false, LINEAR },
+    { "filter-lfo", {
+        { kFilterCutoffId, .3f }, { kFilterResonanceId, .7f }, { kLFOFilterId, .4f }, { kLFOFilterDepthId, .8f }
+    }, false, MODULATED },
+    { "flanger", {
+        { kFlangerRateId, .3f }, { kFlangerWidthId, .5f }, { kFlangerFeedbackId, .6f }, { kFlangerDelayId, .3f },
+        { kFlangerChainId, 1.f }
+    }, false, MODULATED },
+    { "full-chain", {
+        { kDelayFeedbackId, .5f }, { kDelayMixId, .5f },
+        { kBitResolutionId, .5f }, { kBitResolutionChainId, 0.f }, { kLFOBitResolutionId, .3f },
+        { kDecimatorId, .5f }, { kDecimatorChainId, 0.f }, { kLFODecimatorId, .7f },
+        { kFilterCutoffId, .5f }, { kFilterChainId, 1.f }, { kLFOFilterId, .3f },
+        { kFlangerRateId, .3f }, { kFlangerWidthId, .5f }, { kFlangerFeedbackId, .5f }, { kFlangerChainId, 1.f }
+    }, false, QUANTIZED },
+    { "full-chain-offline", {
+        { kDelayFeedbackId, .5f }, { kDelayMixId, .5f },
+        { kBitResolutionId, .5f }, { kBitResolutionChainId, 1.f }, { kLFOBitResolutionId, .3f },
+        { kDecimatorId, .5f }, { kDecimatorChainId, 1.f }, { kLFODecimatorId, .7f },
+        { kFilterCutoffId, .5f }, { kFilterChainId, 0.f }, { kLFOFilterId, .3f },
+        { kFlangerRateId, .3f }, { kFlangerWidthId, .5f }, { kFlangerFeedbackId, .5f }, { kFlangerChainId, 0.f },
+        { kOversamplingId, 1.f / 3.f }
+    }, true, QUANTIZED }
+};
+
+int failures = 0;
+
+/**
+ * generate given test signal (separate channels, each of LENGTH frames)
+ */
+std::vector<std::vector<float>> createSignal( Signal signal )
+{
+    std::vector<std::vector<float>> channels( NUM_CHANNELS, std::vector<float>( LENGTH, 0.f ));
+    uint32_t seed = 1;
+
+    for ( int c = 0; c < NUM_CHANNELS; ++c )
+    {
+        std::vector<float>& channel = channels[ c ];
+
+        switch ( signal ) {
+            default:
+            case IMPULSE:
+                channel[ c * 100 ] = 1.f; // the channels are offset to tell them apart
+                break;
+
+            case SWEEP: {
+                // exponential sweep from 20 Hz to 20 kHz (the channels in opposite directions)
+                double phase = 0.0;
+                for ( int i = 0; i < LENGTH; ++i ) {
+                    double position  = ( double ) i / LENGTH;
+                    double frequency = 20.0 * pow( 1000.0, c == 0 ? position : 1.0 - position );
+                    phase += 2.0 * VST::PI * frequency / SAMPLE_RATE;
+                    channel[ i ] = ( float )( .5 * sin( phase ));
+                }
+                break;
+            }
+
+            case NOISE:
+                for ( int i = 0; i < LENGTH; ++i ) {
+                    seed = seed * 1664525 + 1013904223;
+                    channel[ i ] = ( float )(( int32_t ) seed ) / 2147483648.f * .5f;
+                }
+                break;
+        }
+    }
+    return channels;
+}
+
+/**
+ * render given signal through a RegraderProcess configured by given preset
+ */
+std::vector<std::vector<float>> render( const Preset& preset, Signal signal )
+{
+    float values[ kNumParameters ];
+    ParameterModel::getDefaultValues( values );
+
+    for ( const Parameter& parameter : BASE )
+        values[ parameter.id ] = parameter.value;
+
+    for ( const Parameter& parameter : preset.parameters )
+        values[ parameter.id ] = parameter.value;
+
+    VST::SAMPLE_RATE = ( float ) SAMPLE_RATE;
+
+    RegraderProcess<float>* process = new RegraderProcess<float>( NUM_CHANNELS, BLOCK_SIZE );
+    process->updateSampleRate();
+    ParameterModel::apply( values, process, preset.offline ? QualityProfiles::OFFLINE : QualityProfiles::REALTIME );
+    process->setTempo( TEMPO, 4, 4 );
+
+    std::vector<std::vector<float>> channels = createSignal( signal );
+    float* buffers[ NUM_CHANNELS ];
+
+    int violations = RealtimeGuard::getViolations();
+    {
+        DenormalGuard denormalGuard;
+        RealtimeGuard realtimeGuard;
+
+        for ( int offset = 0; offset < LENGTH; offset += BLOCK_SIZE )
+        {
+            for ( int c = 0; c < NUM_CHANNELS; ++c )
+                buffers[ c ] = channels[ c ].data() + offset;
+
+            process->process( buffers, buffers, NUM_CHANNELS, NUM_CHANNELS, BLOCK_SIZE, BLOCK_SIZE * sizeof( float ));
+        }
+    }
+    delete process;
+
+    if ( RealtimeGuard::getViolations() > violations ) {
+        printf( "FAIL %s (%s): %d allocation or lock calls while processing\n", preset.name, SIGNAL_NAMES[ signal ],
+                RealtimeGuard::getViolations() - violations );
+        ++failures;
+    }
+
+    return channels;
+}
+
+std::string getReferencePath( const std::string& directory, const Preset& preset, Signal signal )
+{
+    return directory + "/" + preset.name + "-" + SIGNAL_NAMES[ signal ] + ".wav";
+}
+
+bool writeReference( const std::string& path, std::vector<std::vector<float>>& channels )
+{
+    WaveWriter writer;
+    float* buffers[ NUM_CHANNELS ];
+
+    for ( int c = 0; c < NUM_CHANNELS; ++c )
+        buffers[ c ] = channels[ c ].data();
+
+    bool success = writer.open( path.c_str(), { NUM_CHANNELS, SAMPLE_RATE, 32, true }) &&
+                   writer.write( buffers, LENGTH ) && writer.close();
+
+    if ( !success )
+        printf( "FAIL could not write %s: %s\n", path.c_str(), writer.getError().c_str());
+
+    return success;
+}
+
+void compare( const std::string& path, const Preset& preset, Signal signal, const char* architecture,
+              const std::vector<std::vector<float>>& channels )
+{
+    WaveReader reader;
+
+    if ( !reader.open( path.c_str())) {
+        printf( "FAIL %s: %s (run with --update to create the reference renders)\n", path.c_str(), reader.getError().c_str());
+        ++failures;
+        return;
+    }
+
+    if ( reader.getFormat().amountOfChannels != NUM_CHANNELS || reader.getLength() != LENGTH ) {
+        printf( "FAIL %s does not match the format of the test renders\n", path.c_str());
+        ++failures;
+        return;
+    }
+
+    std::vector<std::vector<float>> reference( NUM_CHANNELS, std::vector<float>( LENGTH ));
+    float* buffers[ NUM_CHANNELS ];
+
+    for ( int c = 0; c < NUM_CHANNELS; ++c )
+        buffers[ c ] = reference[ c ].data();
+
+    reader.read( buffers, LENGTH );
+
+    double maxError        = 0.0;
+    double errorEnergy     = 0.0;
+    double referenceEnergy = 0.0;
+    int maxErrorFrame      = 0;
+
+    for ( int c = 0; c < NUM_CHANNELS; ++c ) {
+        for ( int i = 0; i < LENGTH; ++i ) {
+            double error = ( double ) channels[ c ][ i ] - reference[ c ][ i ];
+
+            // a non-finite sample always fails
+
+            if ( !std::isfinite( channels[ c ][ i ] ))
+                error = INFINITY;
+
+            if ( fabs( error ) > maxError ) {
+                maxError      = fabs( error );
+                maxErrorFrame = i;
+            }
+            errorEnergy     += error * error;
+            referenceEnergy += ( double ) reference[ c ][ i ] * reference[ c ][ i ];
+        }
+    }
+
+    // the null depth is the level of the difference relative to the level of the reference (in dB)
+
+    double nullDepth = errorEnergy == 0.0 ? -INFINITY : 10.0 * log10( errorEnergy / std::max( referenceEnergy, 1e-30 ));
+    bool passed      = maxError <= preset.tolerance.maxError && nullDepth <= preset.tolerance.nullDepth;
+
+    if ( !passed ) {
+        printf( "FAIL %-8s %-18s %-8s max error %.3g at frame %d (tolerance %.3g), null depth %.1f dB (threshold %.1f dB)\n",
+                architecture, preset.name, SIGNAL_NAMES[ signal ], maxError, maxErrorFrame, preset.tolerance.maxError,
+                nullDepth, preset.tolerance.nullDepth );
+        ++failures;
+    }
+}
+
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( argc < 2 ) {
+        printf( "usage: regrader-golden-test <reference directory> [--update]\n" );
+        return 1;
+    }
+    std::string directory = argv[ 1 ];
+    bool update = argc > 2 && strcmp( argv[ 2 ], "--update" ) == 0;
+
+    // the references are rendered using the scalar kernels
+
+    if ( update ) {
+        Kernels::select( Kernels::Architecture::SCALAR );
+
+        for ( const Preset& preset : PRESETS ) {
+            for ( int signal = 0; signal < SIGNAL_COUNT; ++signal ) {
+                std::vector<std::vector<float>> channels = render( preset, ( Signal ) signal );
+
+                if ( !writeReference( getReferencePath( directory, preset, ( Signal ) signal ), channels ))
+                    return 1;
+            }
+        }
+        printf( "wrote %d reference renders to %s\n", ( int ) PRESETS.size() * SIGNAL_COUNT, directory.c_str());
+        return 0;
+    }
+
+    for ( int i = 0; i < Kernels::Architecture::COUNT; ++i )
+    {
+        Kernels::Architecture::Type architecture = ( Kernels::Architecture::Type ) i;
+        const char* name = Kernels::getArchitectureName( architecture );
+
+        if ( !Kernels::select( architecture )) {
+            printf( "%-8s skipped (not supported)\n", name );
+            continue;
+        }
+        int previousFailures = failures;
+
+        for ( const Preset& preset : PRESETS ) {
+            for ( int signal = 0; signal < SIGNAL_COUNT; ++signal ) {
+                compare( getReferencePath( directory, preset, ( Signal ) signal ), preset, ( Signal ) signal,
+                         name, render( preset, ( Signal ) signal ));
+            }
+        }
+        printf( "%-8s %s\n", name, failures == previousFailures ? "OK" : "FAILED" );
+    }
+    return failures > 0 ? 1 : 0;
+}
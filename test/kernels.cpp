@@ -0,0 +1,329 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "../src/kernels.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/**
+ * validates that the kernels compiled for each instruction set supported by the executing
+ * CPU produce output identical to the scalar reference, for all kernel arguments that
+ * influence how a loop is vectorized (e.g. run lengths, channel counts and unaligned buffers)
+ */
+using namespace Igorski;
+
+namespace {
+
+const int MAX_LENGTH   = 67; // exceeds the width of the widest vector by several remainders
+const int MAX_CHANNELS = 3;
+const int MAX_OFFSET   = 3;  // in samples, to start the buffers at an unaligned address
+
+int failures = 0;
+
+// deterministic noise in the -range to +range range
+
+uint32_t seed = 1;
+
+template <typename SampleType>
+SampleType random( SampleType range )
+{
+    seed = seed * 1664525 + 1013904223;
+    return ( SampleType ) (( int32_t ) seed ) / ( SampleType ) 2147483648.0 * range;
+}
+
+template <typename SampleType>
+std::vector<SampleType> randomBuffer( int length, SampleType range )
+{
+    std::vector<SampleType> buffer( length );
+    for ( SampleType& sample : buffer )
+        sample = random( range );
+
+    return buffer;
+}
+
+template <typename SampleType>
+void expectEqual( const char* architecture, const char* kernel, const SampleType* expected, const SampleType* actual,
+                  int length, int numChannels, int offset )
+{
+    if ( memcmp( expected, actual, length * sizeof( SampleType )) == 0 )
+        return;
+
+    for ( int i = 0; i < length; ++i ) {
+        if ( memcmp( &expected[ i ], &actual[ i ], sizeof( SampleType )) != 0 ) {
+            printf( "FAIL %s %s (%s) at sample %d of %d (channels %d, offset %d): expected %.17g, got %.17g\n",
+                    architecture, kernel, sizeof( SampleType ) == sizeof( float ) ? "float" : "double",
+                    i, length, numChannels, offset, ( double ) expected[ i ], ( double ) actual[ i ] );
+            break;
+        }
+    }
+    ++failures;
+}
+
+template <typename SampleType>
+void expectEqualValue( const char* architecture, const char* kernel, SampleType expected, SampleType actual,
+                       int numChannels, int offset )
+{
+    expectEqual( architecture, kernel, &expected, &actual, 1, numChannels, offset );
+}
+
+/**
+ * runs each kernel of given table and the reference table onto copies of the same input
+ */
+template <typename SampleType>
+void validate( const char* architecture, const Kernels::Table<SampleType>& reference, const Kernels::Table<SampleType>& kernels )
+{
+    for ( int numChannels = 1; numChannels <= MAX_CHANNELS; ++numChannels )
+    for ( int length = 0; length <= MAX_LENGTH; ++length )
+    for ( int offset = 0; offset <= MAX_OFFSET; ++offset )
+    {
+        int samples = length * numChannels;
+
+        // the input exceeds the -1 to +1 range (as can be the case within the effect chain)
+
+        std::vector<SampleType> input   = randomBuffer( samples + offset, ( SampleType ) 2 );
+        std::vector<SampleType> source  = randomBuffer( samples + offset, ( SampleType ) 2 );
+        std::vector<float> ramp         = randomBuffer( length + offset, 1.f );
+        std::vector<SampleType> expected, actual;
+
+        // delay feedback
+
+        expected = actual = input;
+        SampleType expectedPeak = reference.applyFeedback( expected.data() + offset, source.data() + offset, ramp.data() + offset, numChannels, length );
+        SampleType actualPeak   = kernels.applyFeedback( actual.data() + offset, source.data() + offset, ramp.data() + offset, numChannels, length );
+
+        expectEqual( architecture, "applyFeedback", expected.data(), actual.data(), ( int ) input.size(), numChannels, offset );
+        expectEqualValue( architecture, "applyFeedback peak", expectedPeak, actualPeak, numChannels, offset );
+
+        // wet/dry mix of a single channel from interleaved wet frames, into a separate and a shared output
+
+        for ( int c = 0; c < numChannels; ++c ) {
+            std::vector<SampleType> dry = randomBuffer( length + offset, ( SampleType ) 1 );
+
+            expected = actual = randomBuffer( length + offset, ( SampleType ) 1 );
+            reference.mixWetDry( expected.data() + offset, source.data() + offset + c, numChannels, dry.data() + offset, 1, ramp.data() + offset, length );
+            kernels.mixWetDry( actual.data() + offset, source.data() + offset + c, numChannels, dry.data() + offset, 1, ramp.data() + offset, length );
+
+            expectEqual( architecture, "mixWetDry", expected.data(), actual.data(), length + offset, numChannels, offset );
+
+            expected = actual = dry;
+            reference.mixWetDry( expected.data() + offset, source.data() + offset + c, numChannels, expected.data() + offset, 1, ramp.data() + offset, length );
+            kernels.mixWetDry( actual.data() + offset, source.data() + offset + c, numChannels, actual.data() + offset, 1, ramp.data() + offset, length );
+
+            expectEqual( architecture, "mixWetDry (in place)", expected.data(), actual.data(), length + offset, numChannels, offset );
+        }
+
+        // bit crushing at each resolution
+
+        for ( int bits = 1; bits <= 16; ++bits ) {
+            SampleType inputMix  = random(( SampleType ) 1 );
+            SampleType outputMix = random(( SampleType ) 1 );
+
+            expected = actual = input;
+            reference.crush( expected.data() + offset, samples, bits, inputMix, outputMix );
+            kernels.crush( actual.data() + offset, samples, bits, inputMix, outputMix );
+
+            expectEqual( architecture, "crush", expected.data(), actual.data(), ( int ) input.size(), numChannels, offset );
+        }
+
+        // biquad filtering (the coefficients of a resonant low pass filter, as calculated by Filter)
+
+        SampleType c  = 1 / tan(( SampleType ) 3.141592653589793 * ( 20 + random(( SampleType ) 1 ) * random(( SampleType ) 1 ) * 20000 ) / 44100 );
+        SampleType r  = ( SampleType ) 1.4142135623730951 - random(( SampleType ) 1 ) * random(( SampleType ) 1 );
+        SampleType a1 = 1 / ( 1 + r * c + c * c );
+        SampleType b1 = 2 * ( 1 - c * c ) * a1;
+        SampleType b2 = ( 1 - r * c + c * c ) * a1;
+
+        std::vector<SampleType> expectedState = randomBuffer( numChannels * 4, ( SampleType ) 1 );
+        std::vector<SampleType> actualState   = expectedState;
+        SampleType* es = expectedState.data();
+        SampleType* as = actualState.data();
+
+        expected = actual = input;
+        reference.biquad( expected.data() + offset, numChannels, length, a1, 2 * a1, a1, b1, b2,
+                          es, es + numChannels, es + numChannels * 2, es + numChannels * 3 );
+        kernels.biquad( actual.data() + offset, numChannels, length, a1, 2 * a1, a1, b1, b2,
+                        as, as + numChannels, as + numChannels * 2, as + numChannels * 3 );
+
+        expectEqual( architecture, "biquad", expected.data(), actual.data(), ( int ) input.size(), numChannels, offset );
+        expectEqual( architecture, "biquad state", es, as, numChannels * 4, numChannels, offset );
+
+        // limiting, using both knees (the channels are consecutive, non-interleaved buffers)
+
+        for ( int softKnee = 0; softKnee < 2; ++softKnee ) {
+            SampleType gain      = 1 - random(( SampleType ) .5 ) * random(( SampleType ) 1 );
+            SampleType threshold = ( SampleType ) .5 + random(( SampleType ) .5 );
+            SampleType attack    = ( SampleType ) .5 + random(( SampleType ) .5 );
+            SampleType release   = ( SampleType ) .01 + random(( SampleType ) .01 );
+            SampleType trim      = ( SampleType ) 1 + random(( SampleType ) .1 );
+
+            SampleType* expectedChannels[ MAX_CHANNELS ];
+            SampleType* actualChannels[ MAX_CHANNELS ];
+
+            expected = actual = input;
+            for ( int ch = 0; ch < numChannels; ++ch ) {
+                expectedChannels[ ch ] = expected.data() + offset + ch * length;
+                actualChannels[ ch ]   = actual.data() + offset + ch * length;
+            }
+            SampleType expectedGain = reference.limit( expectedChannels, numChannels, length, gain, threshold, attack, release, trim, softKnee == 1 );
+            SampleType actualGain   = kernels.limit( actualChannels, numChannels, length, gain, threshold, attack, release, trim, softKnee == 1 );
+
+            expectEqual( architecture, softKnee ? "limit (soft knee)" : "limit", expected.data(), actual.data(), ( int ) input.size(), numChannels, offset );
+            expectEqualValue( architecture, "limit gain", expectedGain, actualGain, numChannels, offset );
+        }
+
+        // AudioBuffer operations
+
+        SampleType amount = random(( SampleType ) 2 );
+
+        expected = actual = input;
+        reference.scale( expected.data() + offset, samples, amount );
+        kernels.scale( actual.data() + offset, samples, amount );
+
+        expectEqual( architecture, "scale", expected.data(), actual.data(), ( int ) input.size(), numChannels, offset );
+
+        expected = actual = input;
+        reference.mix( expected.data() + offset, source.data() + offset, samples, amount );
+        kernels.mix( actual.data() + offset, source.data() + offset, samples, amount );
+
+        expectEqual( architecture, "mix", expected.data(), actual.data(), ( int ) input.size(), numChannels, offset );
+
+        // silence, with a single non-zero sample at each position
+
+        std::vector<SampleType> silence( samples + offset, ( SampleType ) 0 );
+
+        for ( int i = -1; i < samples; ++i ) {
+            if ( i >= 0 )
+                silence[ offset + i ] = ( i % 2 ) ? ( SampleType ) -1e-30 : ( SampleType ) 1;
+
+            bool expectedZero = reference.isZero( silence.data() + offset, samples );
+            bool actualZero   = kernels.isZero( silence.data() + offset, samples );
+
+            if ( expectedZero != actualZero || expectedZero != ( i < 0 )) {
+                printf( "FAIL %s isZero at sample %d of %d\n", architecture, i, samples );
+                ++failures;
+            }
+            if ( i >= 0 )
+                silence[ offset + i ] = 0;
+        }
+    }
+}
+
+// the linked limiter reduces the gain of any multichannel layout equally for the same signal (e.g. a
+// surround layout is not limited harder than stereo, nor do channels in opposite phase cancel out)
+// while a mono channel is limited as it was prior to multichannel support
+
+template <typename SampleType>
+SampleType limitGain( const Kernels::Table<SampleType>& kernels, SampleType** channels, int numChannels, int length,
+                      bool softKnee )
+{
+    return kernels.limit( channels, numChannels, length, 1, ( SampleType ) .5, ( SampleType ) .5,
+                          ( SampleType ) .01, 1, softKnee );
+}
+
+template <typename SampleType>
+void validateLimiterLayouts( const char* architecture, const Kernels::Table<SampleType>& kernels )
+{
+    const int length = MAX_LENGTH;
+    const int layouts[] = { 1, 2, 4, 6, 12 };
+
+    std::vector<SampleType> signal = randomBuffer( length, ( SampleType ) 1 );
+    SampleType expectedGains[ 2 ]; // for each knee, as determined for the stereo layout
+
+    for ( int numChannels : layouts ) {
+        // the channels of a stereo pair are in phase, those of the wider layouts alternate in phase
+
+        std::vector<std::vector<SampleType>> buffers( numChannels, signal );
+        SampleType* channels[ 12 ];
+
+        for ( int ch = 0; ch < numChannels; ++ch ) {
+            if ( numChannels > 2 && ( ch % 2 ) == 1 ) {
+                for ( SampleType& sample : buffers[ ch ])
+                    sample = -sample;
+            }
+            channels[ ch ] = buffers[ ch ].data();
+        }
+
+        for ( int softKnee = 0; softKnee < 2; ++softKnee ) {
+            SampleType gain = limitGain( kernels, channels, numChannels, length, softKnee == 1 );
+            SampleType expected;
+            const char* reference;
+
+            if ( numChannels == 1 ) {
+                // a mono channel is detected as is, which equals the sum of a stereo pair with a silent channel
+
+                std::vector<SampleType> left = signal, right( length, 0 );
+                SampleType* pair[ 2 ] = { left.data(), right.data() };
+
+                expected  = limitGain( kernels, pair, 2, length, softKnee == 1 );
+                reference = "as for a stereo pair with a silent channel";
+            } else if ( numChannels == 2 ) {
+                expectedGains[ softKnee ] = gain;
+                continue;
+            } else {
+                expected  = expectedGains[ softKnee ];
+                reference = "as for an in phase stereo pair";
+            }
+
+            if ( gain != expected ) {
+                printf( "FAIL %s limit%s gain of %d channels is %f, expected %f (%s)\n", architecture,
+                        softKnee ? " (soft knee)" : "", numChannels, ( double ) gain, ( double ) expected, reference );
+                ++failures;
+            }
+        }
+    }
+}
+
+}
+
+int main()
+{
+    printf( "executing CPU supports %s\n", Kernels::getArchitectureName( Kernels::detect() ));
+
+    for ( int i = 0; i < Kernels::Architecture::COUNT; ++i )
+    {
+        Kernels::Architecture::Type architecture = ( Kernels::Architecture::Type ) i;
+        const char* name = Kernels::getArchitectureName( architecture );
+
+        if ( !Kernels::isSupported( architecture )) {
+            printf( "%-8s skipped (not supported)\n", name );
+            continue;
+        }
+        int previousFailures = failures;
+
+        validate<float> ( name, *Kernels::getTable<float> ( Kernels::Architecture::SCALAR ), *Kernels::getTable<float> ( architecture ));
+        validate<double>( name, *Kernels::getTable<double>( Kernels::Architecture::SCALAR ), *Kernels::getTable<double>( architecture ));
+        validateLimiterLayouts<float> ( name, *Kernels::getTable<float> ( architecture ));
+        validateLimiterLayouts<double>( name, *Kernels::getTable<double>( architecture ));
+
+        // the selected kernels are the kernels of the architecture
+
+        if ( !Kernels::select( architecture ) || &Kernels::get<float>() != Kernels::getTable<float>( architecture )) {
+            printf( "FAIL could not select %s\n", name );
+            ++failures;
+        }
+        printf( "%-8s %s\n", name, failures == previousFailures ? "OK" : "FAILED" );
+    }
+    return failures > 0 ? 1 : 0;
+}
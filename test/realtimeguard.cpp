@@ -0,0 +1,345 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "realtimeguard.h"
+#include <algorithm>
+#include <atomic>
+#include <errno.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>
+#define REALTIMEGUARD_STACK_TRACE
+#endif
+
+#if defined(__GLIBC__)
+#include <dlfcn.h>
+#include <pthread.h>
+#define REALTIMEGUARD_LIBC_HOOKS
+
+// the glibc allocator entry points, these are called by the hooks below
+// (rather than malloc() and free()) so each allocation is reported once
+
+extern "C" {
+    void* __libc_malloc( size_t size );
+    void* __libc_calloc( size_t amount, size_t size );
+    void* __libc_realloc( void* ptr, size_t size );
+    void* __libc_memalign( size_t alignment, size_t size );
+    void  __libc_free( void* ptr );
+}
+#endif
+
+namespace Igorski {
+
+namespace {
+
+const int MAX_REPORTS      = 10; // the amount of violations printed (all are counted)
+const int MAX_STACK_FRAMES = 64;
+
+// the amount of RealtimeGuards in scope on the calling thread, while reporting a violation
+// the hooks are suspended as printing the stack trace can itself allocate and lock
+
+thread_local int realtimeDepth = 0;
+thread_local bool isReporting  = false;
+
+std::atomic<int> violations( 0 );
+
+void report( const char* call, size_t size )
+{
+    if ( realtimeDepth == 0 || isReporting )
+        return;
+
+    isReporting = true;
+
+    if ( ++violations <= MAX_REPORTS )
+    {
+        if ( size > 0 )
+            fprintf( stderr, "realtime violation: %s (%zu bytes) on the audio thread\n", call, size );
+        else
+            fprintf( stderr, "realtime violation: %s on the audio thread\n", call );
+
+#ifdef REALTIMEGUARD_STACK_TRACE
+        void* frames[ MAX_STACK_FRAMES ];
+        int amountOfFrames = backtrace( frames, MAX_STACK_FRAMES );
+
+        // omit the frame of this function
+        backtrace_symbols_fd( frames + 1, amountOfFrames - 1, fileno( stderr ));
+#endif
+        fprintf( stderr, "\n" );
+    }
+    isReporting = false;
+}
+
+#if !defined(_WIN32)
+
+void* allocate( size_t size, const char* call )
+{
+    report( call, size );
+#ifdef REALTIMEGUARD_LIBC_HOOKS
+    return __libc_malloc( size > 0 ? size : 1 );
+#else
+    return malloc( size > 0 ? size : 1 );
+#endif
+}
+
+void* allocateAligned( size_t size, size_t alignment, const char* call )
+{
+    report( call, size );
+#ifdef REALTIMEGUARD_LIBC_HOOKS
+    return __libc_memalign( alignment, size > 0 ? size : 1 );
+#else
+    void* ptr = nullptr;
+    return posix_memalign( &ptr, std::max( alignment, sizeof( void* )), size > 0 ? size : 1 ) == 0 ? ptr : nullptr;
+#endif
+}
+
+void deallocate( void* ptr, const char* call )
+{
+    if ( ptr == nullptr )
+        return;
+
+    report( call, 0 );
+#ifdef REALTIMEGUARD_LIBC_HOOKS
+    __libc_free( ptr );
+#else
+    free( ptr );
+#endif
+}
+
+#endif
+
+}
+
+RealtimeGuard::RealtimeGuard()
+{
+#ifdef REALTIMEGUARD_STACK_TRACE
+    // the first stack trace loads the unwinder (allocating), do so before entering the realtime scope
+
+    static int warmUp = [] { void* frame; return backtrace( &frame, 1 ); }();
+    ( void ) warmUp;
+#endif
+    ++realtimeDepth;
+}
+
+RealtimeGuard::~RealtimeGuard()
+{
+    --realtimeDepth;
+}
+
+int RealtimeGuard::getViolations()
+{
+    return violations;
+}
+
+}
+
+/* replacements of the global allocation functions */
+
+#if !defined(_WIN32)
+
+using Igorski::allocate;
+using Igorski::allocateAligned;
+using Igorski::deallocate;
+
+void* operator new( size_t size )
+{
+    void* ptr = allocate( size, "operator new" );
+
+    if ( ptr == nullptr )
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void* operator new[]( size_t size )
+{
+    void* ptr = allocate( size, "operator new[]" );
+
+    if ( ptr == nullptr )
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) noexcept
+{
+    return allocate( size, "operator new" );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& ) noexcept
+{
+    return allocate( size, "operator new[]" );
+}
+
+void* operator new( size_t size, std::align_val_t alignment )
+{
+    void* ptr = allocateAligned( size, ( size_t ) alignment, "operator new" );
+
+    if ( ptr == nullptr )
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void* operator new[]( size_t size, std::align_val_t alignment )
+{
+    void* ptr = allocateAligned( size, ( size_t ) alignment, "operator new[]" );
+
+    if ( ptr == nullptr )
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void* operator new( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+    return allocateAligned( size, ( size_t ) alignment, "operator new" );
+}
+
+void* operator new[]( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+    return allocateAligned( size, ( size_t ) alignment, "operator new[]" );
+}
+
+void operator delete( void* ptr ) noexcept                                    { deallocate( ptr, "operator delete" ); }
+void operator delete[]( void* ptr ) noexcept                                  { deallocate( ptr, "operator delete[]" ); }
+void operator delete( void* ptr, size_t ) noexcept                            { deallocate( ptr, "operator delete" ); }
+void operator delete[]( void* ptr, size_t ) noexcept                          { deallocate( ptr, "operator delete[]" ); }
+void operator delete( void* ptr, const std::nothrow_t& ) noexcept             { deallocate( ptr, "operator delete" ); }
+void operator delete[]( void* ptr, const std::nothrow_t& ) noexcept           { deallocate( ptr, "operator delete[]" ); }
+void operator delete( void* ptr, std::align_val_t ) noexcept                  { deallocate( ptr, "operator delete" ); }
+void operator delete[]( void* ptr, std::align_val_t ) noexcept                { deallocate( ptr, "operator delete[]" ); }
+void operator delete( void* ptr, size_t, std::align_val_t ) noexcept          { deallocate( ptr, "operator delete" ); }
+void operator delete[]( void* ptr, size_t, std::align_val_t ) noexcept        { deallocate( ptr, "operator delete[]" ); }
+void operator delete( void* ptr, std::align_val_t, const std::nothrow_t& ) noexcept   { deallocate( ptr, "operator delete" ); }
+void operator delete[]( void* ptr, std::align_val_t, const std::nothrow_t& ) noexcept { deallocate( ptr, "operator delete[]" ); }
+
+#endif
+
+/* replacements of the C allocation and lock functions (these interpose the glibc symbols) */
+
+#ifdef REALTIMEGUARD_LIBC_HOOKS
+
+namespace {
+
+// the lock functions are resolved from the next library defining them (glibc) on first use
+
+template <typename Function>
+Function resolve( std::atomic<Function>& function, const char* name )
+{
+    Function resolved = function.load( std::memory_order_relaxed );
+
+    if ( resolved == nullptr ) {
+        bool wasReporting = Igorski::isReporting;
+        Igorski::isReporting = true;
+        resolved = ( Function ) dlsym( RTLD_NEXT, name );
+        Igorski::isReporting = wasReporting;
+        function.store( resolved, std::memory_order_relaxed );
+    }
+    return resolved;
+}
+
+typedef int ( *MutexFunction  )( pthread_mutex_t* );
+typedef int ( *RWLockFunction )( pthread_rwlock_t* );
+
+std::atomic<MutexFunction>  mutexLock( nullptr );
+std::atomic<RWLockFunction> readLock( nullptr );
+std::atomic<RWLockFunction> writeLock( nullptr );
+
+}
+
+extern "C" {
+
+void* malloc( size_t size )
+{
+    Igorski::report( "malloc", size );
+    return __libc_malloc( size );
+}
+
+void* calloc( size_t amount, size_t size )
+{
+    Igorski::report( "calloc", amount * size );
+    return __libc_calloc( amount, size );
+}
+
+void* realloc( void* ptr, size_t size )
+{
+    Igorski::report( "realloc", size );
+    return __libc_realloc( ptr, size );
+}
+
+void free( void* ptr )
+{
+    if ( ptr == nullptr )
+        return;
+
+    Igorski::report( "free", 0 );
+    __libc_free( ptr );
+}
+
+void* memalign( size_t alignment, size_t size )
+{
+    Igorski::report( "memalign", size );
+    return __libc_memalign( alignment, size );
+}
+
+void* aligned_alloc( size_t alignment, size_t size )
+{
+    Igorski::report( "aligned_alloc", size );
+    return __libc_memalign( alignment, size );
+}
+
+int posix_memalign( void** ptr, size_t alignment, size_t size )
+{
+    Igorski::report( "posix_memalign", size );
+    void* allocated = __libc_memalign( alignment, size );
+
+    if ( allocated == nullptr )
+        return ENOMEM;
+
+    *ptr = allocated;
+    return 0;
+}
+
+int pthread_mutex_lock( pthread_mutex_t* mutex )
+{
+    Igorski::report( "pthread_mutex_lock", 0 );
+    return resolve( mutexLock, "pthread_mutex_lock" )( mutex );
+}
+
+int pthread_rwlock_rdlock( pthread_rwlock_t* lock )
+{
+    Igorski::report( "pthread_rwlock_rdlock", 0 );
+    return resolve( readLock, "pthread_rwlock_rdlock" )( lock );
+}
+
+int pthread_rwlock_wrlock( pthread_rwlock_t* lock )
+{
+    Igorski::report( "pthread_rwlock_wrlock", 0 );
+    return resolve( writeLock, "pthread_rwlock_wrlock" )( lock );
+}
+
+}
+
+#endif
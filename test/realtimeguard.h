@@ -0,0 +1,56 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __REALTIMEGUARD_H_INCLUDED__
+#define __REALTIMEGUARD_H_INCLUDED__
+
+/**
+ * RealtimeGuard marks the calling thread as a realtime (audio) thread for as long as it
+ * is in scope. Create one on the stack around a process() call in a test.
+ *
+ * While a thread is marked, each call it makes to the global operator new and delete,
+ * malloc, calloc, realloc and free or pthread_mutex_lock and the read-write lock
+ * equivalents is a violation : the allocator and a contended lock can block the audio
+ * thread for an unbounded time. Each violation is counted and the first ones are printed
+ * to stderr along with the stack trace leading to the call, so the test can fail when
+ * getViolations() returns a non-zero value. Non-blocking calls (pthread_mutex_trylock) are allowed.
+ *
+ * The hooks replace the allocation functions of the executable the guard is linked into
+ * (see test/realtimeguard.cpp), as such it should only be linked into tests. The operator
+ * new and delete hooks are supported on all platforms but Windows, the malloc and lock hooks
+ * require glibc (Linux) and stack traces require glibc or macOS. Link with exported symbols
+ * (e.g. -rdynamic) to have the stack traces list function names.
+ */
+namespace Igorski {
+class RealtimeGuard
+{
+    public:
+        RealtimeGuard();
+        ~RealtimeGuard();
+
+        // the amount of allocations and locks made by the realtime threads of the process
+
+        static int getViolations();
+};
+}
+
+#endif
@@ -0,0 +1,398 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "../src/vst.h"
+#include "../src/paramids.h"
+#include "../src/parametermodel.h"
+#include "realtimeguard.h"
+#include "public.sdk/source/vst/hosting/parameterchanges.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+/**
+ * drives Regrader::process() as a host would, using blocks of randomized sizes during which the
+ * parameters change densely (several automation points per block for each parameter of paramids.h),
+ * the effects are rerouted and the tempo changes. The processing time of each block is recorded to
+ * report the distribution of the block times, as the rare slow blocks (rather than the average)
+ * cause the audio thread to miss its deadline. Each scenario is also run in isolation, to attribute
+ * the slow blocks to the parameter transitions causing them
+ *
+ * usage: regrader-stress [--blocks <amount>] [--seed <value>] [--double]
+ * fails when the output contains non-finite samples or when process() allocates or locks (see realtimeguard.h)
+ */
+using namespace Igorski;
+
+namespace {
+
+const double SAMPLE_RATE    = 44100.0;
+const int MAX_BLOCK_SIZE    = 2048;
+const int NUM_CHANNELS      = 2;
+const int MAX_POINTS        = 8;  // automation points per parameter per block
+const int SLOWEST_BLOCKS    = 5;  // amount of slowest blocks listed for the full storm
+
+typedef std::chrono::steady_clock Clock;
+
+// the block sizes hosts commonly use, hosts splitting their blocks at automation points
+// or loop boundaries deliver arbitrary sizes, which are drawn in a quarter of all blocks
+
+const int COMMON_BLOCK_SIZES[] = { 32, 64, 128, 256, 512, 1024, 2048 };
+
+uint32_t seed = 1;
+
+// deterministic random value in the 0 - 1 range
+
+double random()
+{
+    seed = seed * 1664525 + 1013904223;
+    return ( double )( seed >> 8 ) / ( double )( 1 << 24 );
+}
+
+int randomInt( int min, int max )
+{
+    return min + std::min( max - min, ( int )( random() * ( max - min + 1 )));
+}
+
+struct Scenario {
+    std::string name;
+    std::vector<int> parameters; // the ids of the parameters changing during each block
+    bool tempoChanges;           // whether the tempo and time signature change for each block
+    int blocks;
+};
+
+struct BlockTime {
+    double ns;
+    double load; // the processing time relative to the duration of the block
+    int size;
+};
+
+struct Report {
+    int blocks;
+    double percentiles[ 3 ]; // 50, 99 and 99.9 (in nanoseconds)
+    double maxNs;
+    double maxLoad;
+    std::vector<BlockTime> slowest; // the blocks with the highest load
+};
+
+int failures = 0;
+
+/**
+ * the Regrader processor along with the buffers and structures a host
+ * provides to its process() call, for the maximum block size
+ */
+template <typename SampleType>
+class Host
+{
+    public:
+        Host()
+        {
+            _regrader = new Regrader();
+            _regrader->initialize( nullptr );
+
+            ProcessSetup setup = {
+                kRealtime, sizeof( SampleType ) == sizeof( double ) ? kSample64 : kSample32, MAX_BLOCK_SIZE, SAMPLE_RATE
+            };
+            _regrader->setupProcessing( setup );
+            _regrader->setActive( true );
+            _regrader->setProcessing( true );
+
+            // the queues are created upfront, so the harness itself does not allocate while processing
+
+            _changes.setMaxParameters( kNumParameters );
+
+            for ( int c = 0; c < NUM_CHANNELS; ++c ) {
+                _inputs.push_back ( std::vector<SampleType>( MAX_BLOCK_SIZE, 0 ));
+                _outputs.push_back( std::vector<SampleType>( MAX_BLOCK_SIZE, 0 ));
+                _in [ c ] = _inputs [ c ].data();
+                _out[ c ] = _outputs[ c ].data();
+            }
+            _context.state      = ProcessContext::kTempoValid | ProcessContext::kTimeSigValid;
+            _context.sampleRate = SAMPLE_RATE;
+            _context.tempo      = 120.0;
+            _context.timeSigNumerator   = 4;
+            _context.timeSigDenominator = 4;
+        }
+
+        ~Host()
+        {
+            _regrader->setProcessing( false );
+            _regrader->setActive( false );
+            _regrader->terminate();
+            _regrader->release();
+        }
+
+        Report run( const Scenario& scenario )
+        {
+            std::vector<BlockTime> times;
+            times.reserve( scenario.blocks );
+
+            for ( int block = 0; block < scenario.blocks; ++block )
+            {
+                int blockSize = random() < .75 ? COMMON_BLOCK_SIZES[ randomInt( 0, 6 )] : randomInt( 1, MAX_BLOCK_SIZE );
+
+                prepareInput( blockSize );
+                prepareChanges( scenario, blockSize );
+
+                if ( scenario.tempoChanges ) {
+                    _context.tempo              = 40.0 + random() * 200.0;
+                    _context.timeSigNumerator   = randomInt( 1, 16 );
+                    _context.timeSigDenominator = 1 << randomInt( 0, 4 );
+                }
+                _context.projectTimeSamples += blockSize;
+
+                AudioBusBuffers input, output;
+                input.numChannels  = output.numChannels = NUM_CHANNELS;
+                input.silenceFlags = _silent ? ( 1 << NUM_CHANNELS ) - 1 : 0;
+                setChannelBuffers( input,  _in );
+                setChannelBuffers( output, _out );
+
+                ProcessData data;
+                data.processMode           = kRealtime;
+                data.symbolicSampleSize    = sizeof( SampleType ) == sizeof( double ) ? kSample64 : kSample32;
+                data.numSamples            = blockSize;
+                data.numInputs             = 1;
+                data.numOutputs            = 1;
+                data.inputs                = &input;
+                data.outputs               = &output;
+                data.inputParameterChanges = &_changes;
+                data.processContext        = &_context;
+
+                double ns;
+                {
+                    RealtimeGuard realtimeGuard;
+
+                    Clock::time_point start = Clock::now();
+                    _regrader->process( data );
+                    ns = ( double ) std::chrono::duration_cast<std::chrono::nanoseconds>( Clock::now() - start ).count();
+                }
+
+                times.push_back({ ns, ns / ( blockSize / SAMPLE_RATE * 1e9 ), blockSize });
+
+                validateOutput( scenario, blockSize );
+            }
+            return createReport( times );
+        }
+
+    private:
+        Regrader* _regrader;
+        ParameterChanges _changes;
+        ProcessContext _context;
+        std::vector<std::vector<SampleType>> _inputs;
+        std::vector<std::vector<SampleType>> _outputs;
+        SampleType* _in [ NUM_CHANNELS ];
+        SampleType* _out[ NUM_CHANNELS ];
+        bool _silent = false;
+
+        // noise, interrupted by silent stretches (so the processor falls idle and wakes up)
+
+        void prepareInput( int blockSize )
+        {
+            if ( random() < .1 )
+                _silent = !_silent;
+
+            for ( int c = 0; c < NUM_CHANNELS; ++c ) {
+                for ( int i = 0; i < blockSize; ++i )
+                    _inputs[ c ][ i ] = _silent ? 0 : ( SampleType )(( random() * 2.0 - 1.0 ) * .5 );
+            }
+        }
+
+        // add several points at random offsets for each of the changing parameters
+        // the routing parameters flip between the positions before and after the delay
+
+        void prepareChanges( const Scenario& scenario, int blockSize )
+        {
+            _changes.clearQueue();
+
+            for ( int paramId : scenario.parameters )
+            {
+                int32 index;
+                IParamValueQueue* queue = _changes.addParameterData( paramId, index );
+
+                if ( queue == nullptr )
+                    continue;
+
+                bool isSwitch = paramId == kDelayHostSyncId || paramId == kBitResolutionChainId || paramId == kDecimatorChainId ||
+                                paramId == kFilterChainId || paramId == kFlangerChainId || paramId == kBypassId;
+
+                for ( int point = randomInt( 1, MAX_POINTS ); point > 0; --point ) {
+                    double value = isSwitch ? ( random() < .5 ? 0.0 : 1.0 ) : random();
+                    queue->addPoint( randomInt( 0, blockSize - 1 ), value, index );
+                }
+            }
+        }
+
+        void setChannelBuffers( AudioBusBuffers& buffers, SampleType** channels );
+
+        void validateOutput( const Scenario& scenario, int blockSize )
+        {
+            for ( int c = 0; c < NUM_CHANNELS; ++c ) {
+                for ( int i = 0; i < blockSize; ++i ) {
+                    if ( !std::isfinite( _outputs[ c ][ i ])) {
+                        printf( "FAIL %s: non-finite output in channel %d at sample %d of %d\n",
+                                scenario.name.c_str(), c, i, blockSize );
+                        ++failures;
+                        return;
+                    }
+                }
+            }
+        }
+
+        static Report createReport( std::vector<BlockTime>& times )
+        {
+            Report report;
+            report.blocks = ( int ) times.size();
+
+            std::vector<double> ns;
+            for ( const BlockTime& time : times )
+                ns.push_back( time.ns );
+
+            std::sort( ns.begin(), ns.end());
+
+            const double percentiles[] = { .5, .99, .999 };
+
+            for ( int i = 0; i < 3; ++i )
+                report.percentiles[ i ] = ns[ std::min( ns.size() - 1, ( size_t )( percentiles[ i ] * ns.size()))];
+
+            report.maxNs = ns.back();
+
+            std::sort( times.begin(), times.end(), []( const BlockTime& a, const BlockTime& b ) { return a.load > b.load; });
+
+            report.maxLoad = times.front().load;
+            report.slowest.assign( times.begin(), times.begin() + std::min( SLOWEST_BLOCKS, ( int ) times.size()));
+
+            return report;
+        }
+};
+
+template <>
+void Host<float>::setChannelBuffers( AudioBusBuffers& buffers, float** channels )
+{
+    buffers.channelBuffers32 = channels;
+}
+
+template <>
+void Host<double>::setChannelBuffers( AudioBusBuffers& buffers, double** channels )
+{
+    buffers.channelBuffers64 = channels;
+}
+
+void printReport( const std::string& name, const Report& report )
+{
+    printf( "%-26s %8d %10.1f %10.1f %10.1f %10.1f %9.1f%%\n", name.c_str(), report.blocks,
+            report.percentiles[ 0 ] / 1000.0, report.percentiles[ 1 ] / 1000.0, report.percentiles[ 2 ] / 1000.0,
+            report.maxNs / 1000.0, report.maxLoad * 100.0 );
+}
+
+template <typename SampleType>
+void run( int blocks )
+{
+    std::vector<int> allParameters;
+    for ( int paramId = 0; paramId < kNumParameters; ++paramId )
+        allParameters.push_back( paramId );
+
+    // the scenarios in isolation run a fraction of the blocks of the full storm
+
+    int isolatedBlocks = std::max( 100, blocks / 10 );
+
+    std::vector<Scenario> scenarios = {
+        { "steady (no changes)",    {},            false, isolatedBlocks },
+        { "full storm",             allParameters, true,  blocks },
+        { "tempo changes",          {},            true,  isolatedBlocks },
+        { "routing flips",          { kBitResolutionChainId, kDecimatorChainId, kFilterChainId, kFlangerChainId }, false, isolatedBlocks }
+    };
+    for ( int paramId = 0; paramId < kNumParameters; ++paramId )
+        scenarios.push_back({ ParameterModel::getName( paramId ), { paramId }, false, isolatedBlocks });
+
+    printf( "block times at %d-bit precision (%.0f Hz, %d channels, block sizes 1 - %d)\n\n",
+            ( int ) sizeof( SampleType ) * 8, SAMPLE_RATE, NUM_CHANNELS, MAX_BLOCK_SIZE );
+    printf( "%-26s %8s %10s %10s %10s %10s %10s\n", "scenario", "blocks", "p50 us", "p99 us", "p99.9 us", "max us", "max load" );
+
+    Report storm;
+
+    for ( const Scenario& scenario : scenarios )
+    {
+        // each scenario starts from a newly created processor, so state of the previous scenarios
+        // (e.g. the feedback of a long delay) does not influence its results
+
+        int violations = RealtimeGuard::getViolations();
+
+        Host<SampleType>* host = new Host<SampleType>();
+        Report report = host->run( scenario );
+        delete host;
+
+        printReport( scenario.name, report );
+
+        if ( RealtimeGuard::getViolations() > violations ) {
+            printf( "FAIL %s: %d allocation or lock calls on the audio thread\n",
+                    scenario.name.c_str(), RealtimeGuard::getViolations() - violations );
+            ++failures;
+        }
+
+        if ( scenario.name == "full storm" )
+            storm = report;
+    }
+
+    // the load is the processing time relative to the duration of the block, the
+    // audio thread misses its deadline when it exceeds 100% (in practice, far less)
+
+    printf( "\nslowest blocks of the full storm (relative to their duration):\n" );
+
+    for ( const BlockTime& time : storm.slowest )
+        printf( "  %5d samples %10.1f us %9.1f%%\n", time.size, time.ns / 1000.0, time.load * 100.0 );
+
+    printf( "\n" );
+}
+
+}
+
+int main( int argc, char* argv[] )
+{
+    int blocks = 20000;
+    bool doublePrecision = false;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        if ( !strcmp( argv[ i ], "--blocks" ) && i + 1 < argc )
+            blocks = std::max( 1, atoi( argv[ ++i ]));
+        else if ( !strcmp( argv[ i ], "--seed" ) && i + 1 < argc )
+            seed = ( uint32_t ) strtoul( argv[ ++i ], nullptr, 10 );
+        else if ( !strcmp( argv[ i ], "--double" ))
+            doublePrecision = true;
+        else {
+            printf( "usage: regrader-stress [--blocks <amount>] [--seed <value>] [--double]\n" );
+            return 1;
+        }
+    }
+
+    if ( doublePrecision )
+        run<double>( blocks );
+    else
+        run<float>( blocks );
+
+    return failures > 0 ? 1 : 0;
+}